@@ -0,0 +1,168 @@
+#include "ChunkCache.h"
+
+#include <algorithm>
+
+#include "GridStorage.h"
+#include "Maze.h"
+#include "Random.h"
+
+namespace {
+
+std::uint64_t hashOf(std::uint64_t seed, std::int64_t chunkX, std::int64_t chunkY, std::uint64_t salt) {
+    return Random::mix(seed ^ Random::mix(static_cast<std::uint64_t>(chunkX) ^
+                                          Random::mix(static_cast<std::uint64_t>(chunkY) ^ Random::mix(salt))));
+}
+
+const std::uint64_t SALT_INTERIOR = 1;
+const std::uint64_t SALT_TOP_EDGE = 2;
+const std::uint64_t SALT_LEFT_EDGE = 3;
+
+}  // namespace
+
+ChunkCache::ChunkCache(std::uint64_t seed)
+    : m_seed(seed), m_stopping(false), m_generated(0) {
+    m_worker = std::thread(&ChunkCache::workerLoop, this);
+}
+
+ChunkCache::~ChunkCache() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_worker.join();
+}
+
+std::int64_t ChunkCache::chunkOf(std::int64_t world) {
+    std::int64_t size = chunkGridSize();
+    return world >= 0 ? world / size : -((-world + size - 1) / size);
+}
+
+bool ChunkCache::isWall(std::int64_t worldX, std::int64_t worldY) {
+    std::int64_t chunkX = chunkOf(worldX);
+    std::int64_t chunkY = chunkOf(worldY);
+    auto chunk = getChunk(chunkX, chunkY);
+
+    int localX = static_cast<int>(worldX - chunkX * chunkGridSize());
+    int localY = static_cast<int>(worldY - chunkY * chunkGridSize());
+    return chunk->cells[localY * chunkGridSize() + localX] == CELL_WALL;
+}
+
+std::shared_ptr<const ChunkCache::Chunk> ChunkCache::getChunk(std::int64_t chunkX, std::int64_t chunkY) {
+    std::uint64_t key = keyOf(chunkX, chunkY);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+            return it->second.chunk;
+        }
+    }
+
+    // Not cached (or not prefetched in time): generate here
+    auto chunk = generate(chunkX, chunkY);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_generated++;
+    if (m_entries.find(key) == m_entries.end()) {
+        insertLocked(key, chunk);
+    }
+    return chunk;
+}
+
+void ChunkCache::prefetch(std::int64_t chunkX, std::int64_t chunkY) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_entries.count(keyOf(chunkX, chunkY)) > 0) {
+            return;
+        }
+        m_queue.push_back({chunkX, chunkY});
+    }
+    m_wake.notify_one();
+}
+
+int ChunkCache::getGeneratedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_generated;
+}
+
+int ChunkCache::getCachedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_entries.size());
+}
+
+std::shared_ptr<const ChunkCache::Chunk> ChunkCache::generate(std::int64_t chunkX, std::int64_t chunkY) const {
+    const int size = chunkGridSize();
+
+    // Interior: a DFS maze with its own wall border, of which the chunk keeps the top and left lines
+    GridStorage grid(size + 1, size + 1);
+    Random rng(hashOf(m_seed, chunkX, chunkY, SALT_INTERIOR));
+    Maze::carveDFS(grid, 1, 1, rng);
+
+    auto chunk = std::make_shared<Chunk>();
+    chunk->cells.resize(size * size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            chunk->cells[y * size + x] = grid.get(x, y);
+        }
+    }
+
+    // Doors: each edge is seeded from the edge itself, so the neighbor on the other side agrees
+    auto openDoors = [&](std::uint64_t edgeHash, bool topEdge) {
+        Random edgeRng(edgeHash);
+        for (int door = 0; door < ENDLESS_DOORS_PER_EDGE; ++door) {
+            int position = edgeRng.uniformInt(0, ENDLESS_CHUNK_CELLS - 1) * 2 + 1;
+            if (topEdge) {
+                chunk->cells[position] = CELL_EMPTY;
+            } else {
+                chunk->cells[position * size] = CELL_EMPTY;
+            }
+        }
+    };
+    openDoors(hashOf(m_seed, chunkX, chunkY, SALT_TOP_EDGE), true);
+    openDoors(hashOf(m_seed, chunkX, chunkY, SALT_LEFT_EDGE), false);
+
+    return chunk;
+}
+
+void ChunkCache::insertLocked(std::uint64_t key, std::shared_ptr<const Chunk> chunk) {
+    m_lru.push_front(key);
+    m_entries[key] = {std::move(chunk), m_lru.begin()};
+
+    while (m_entries.size() > static_cast<size_t>(ENDLESS_CHUNK_CACHE_SIZE)) {
+        m_entries.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+void ChunkCache::workerLoop() {
+    while (true) {
+        std::pair<std::int64_t, std::int64_t> request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            request = m_queue.front();
+            m_queue.pop_front();
+            if (m_entries.count(keyOf(request.first, request.second)) > 0) {
+                continue;
+            }
+        }
+
+        auto chunk = generate(request.first, request.second);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_generated++;
+        std::uint64_t key = keyOf(request.first, request.second);
+        if (m_entries.find(key) == m_entries.end()) {
+            insertLocked(key, chunk);
+        }
+    }
+}
+
+std::uint64_t ChunkCache::keyOf(std::int64_t chunkX, std::int64_t chunkY) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkY)) << 32) |
+           static_cast<std::uint32_t>(chunkX);
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Config.h"
+
+/**
+ * @brief LRU cache of deterministically generated maze chunks for endless mode
+ *
+ * The endless world is tiled into chunks of ENDLESS_CHUNK_CELLS x
+ * ENDLESS_CHUNK_CELLS logical cells. Each chunk owns its top and left wall
+ * lines; its interior is a DFS maze seeded from (seed, chunk coordinates),
+ * and every shared edge gets doors seeded from the edge itself, so both
+ * neighbors agree on the border and the whole world stays connected.
+ *
+ * At most ENDLESS_CHUNK_CACHE_SIZE chunks are kept, so memory stays constant
+ * however far the player travels. A worker thread generates prefetched
+ * chunks ahead of the player.
+ */
+class ChunkCache {
+   public:
+    /**
+     * @brief A generated chunk: (2 * ENDLESS_CHUNK_CELLS)^2 grid cells, row-major
+     */
+    struct Chunk {
+        std::vector<std::uint8_t> cells;  ///< 0=path, 1=wall
+    };
+
+    /**
+     * @brief Constructs the cache and starts the prefetch worker
+     *
+     * @param seed World seed
+     */
+    explicit ChunkCache(std::uint64_t seed);
+
+    /**
+     * @brief Stops the prefetch worker
+     */
+    ~ChunkCache();
+
+    ChunkCache(const ChunkCache&) = delete;
+    ChunkCache& operator=(const ChunkCache&) = delete;
+
+    /**
+     * @brief Checks if a world grid position is a wall
+     *
+     * @param worldX X coordinate in world grid space (any value)
+     * @param worldY Y coordinate in world grid space (any value)
+     * @return true if the position is a wall
+     *
+     * Generates the chunk on the calling thread if it isn't cached yet.
+     */
+    bool isWall(std::int64_t worldX, std::int64_t worldY);
+
+    /**
+     * @brief Gets a chunk, generating it on the calling thread if needed
+     *
+     * @param chunkX Chunk X coordinate
+     * @param chunkY Chunk Y coordinate
+     * @return Shared pointer to the chunk (stays valid after eviction)
+     */
+    std::shared_ptr<const Chunk> getChunk(std::int64_t chunkX, std::int64_t chunkY);
+
+    /**
+     * @brief Queues a chunk for background generation
+     *
+     * @param chunkX Chunk X coordinate
+     * @param chunkY Chunk Y coordinate
+     */
+    void prefetch(std::int64_t chunkX, std::int64_t chunkY);
+
+    /**
+     * @brief Gets the number of chunks generated so far
+     *
+     * @return Generation count (foreground and background)
+     */
+    int getGeneratedCount() const;
+
+    /**
+     * @brief Gets the number of cached chunks
+     *
+     * @return Cached chunk count (at most ENDLESS_CHUNK_CACHE_SIZE)
+     */
+    int getCachedCount() const;
+
+    /**
+     * @brief Gets the grid size of one chunk side
+     *
+     * @return Grid cells per chunk side
+     */
+    static int chunkGridSize() { return ENDLESS_CHUNK_CELLS * 2; }
+
+    /**
+     * @brief Converts a world grid coordinate to its chunk coordinate
+     *
+     * @param world World grid coordinate
+     * @return Chunk coordinate (rounds toward negative infinity)
+     */
+    static std::int64_t chunkOf(std::int64_t world);
+
+   private:
+    /**
+     * @brief Generates a chunk from the seed and its coordinates
+     *
+     * @param chunkX Chunk X coordinate
+     * @param chunkY Chunk Y coordinate
+     * @return The generated chunk
+     */
+    std::shared_ptr<const Chunk> generate(std::int64_t chunkX, std::int64_t chunkY) const;
+
+    /**
+     * @brief Inserts a chunk as most recently used, evicting the oldest if full
+     *
+     * @param key Chunk key
+     * @param chunk Chunk to insert
+     *
+     * Caller must hold m_mutex.
+     */
+    void insertLocked(std::uint64_t key, std::shared_ptr<const Chunk> chunk);
+
+    /**
+     * @brief Worker loop: generates queued chunks until stopped
+     */
+    void workerLoop();
+
+    /**
+     * @brief Packs chunk coordinates into a cache key
+     */
+    static std::uint64_t keyOf(std::int64_t chunkX, std::int64_t chunkY);
+
+    struct Entry {
+        std::shared_ptr<const Chunk> chunk;
+        std::list<std::uint64_t>::iterator lruPosition;
+    };
+
+    std::uint64_t m_seed;                                   ///< World seed
+    mutable std::mutex m_mutex;                             ///< Guards everything below
+    std::unordered_map<std::uint64_t, Entry> m_entries;     ///< Cached chunks by key
+    std::list<std::uint64_t> m_lru;                         ///< Keys, most recently used first
+    std::deque<std::pair<std::int64_t, std::int64_t>> m_queue;  ///< Chunks waiting for the worker
+    std::condition_variable m_wake;                         ///< Signals queued work or shutdown
+    bool m_stopping;                                        ///< Worker shutdown flag
+    int m_generated;                                        ///< Chunks generated so far
+    std::thread m_worker;                                   ///< Prefetch worker thread
+};
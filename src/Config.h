@@ -1,32 +1,85 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 
 /**
  * @file Config.h
  * @brief Game configuration constants
  */
 
-// Maze dimensions
-const int MAZE_WIDTH = 21;  
-const int MAZE_HEIGHT = 21; 
+// Default maze dimensions in logical cells (overridable on the command line)
+const int DEFAULT_MAZE_WIDTH = 21;
+const int DEFAULT_MAZE_HEIGHT = 21;
+const int MIN_MAZE_SIZE = 5;
 const int CELL_SIZE = 36; 
 const float SPRITE_SCALE_MULTIPLIER = 2.4f;
 const float ITEM_SPRITE_SCALE_MULTIPLIER = 1.5f;
 const float ITEM_ANIMATION_DELAY = 0.3f; 
 
-// Grid dimensions (includes walls between cells)
-const int GRID_WIDTH = MAZE_WIDTH * 2 + 1;    ///< grid width (51)
-const int GRID_HEIGHT = MAZE_HEIGHT * 2 + 1;  ///< grid height (51)
-
-// Window dimensions
-const int WINDOW_WIDTH = GRID_WIDTH * CELL_SIZE;    
-const int WINDOW_HEIGHT = GRID_HEIGHT * CELL_SIZE; 
+// Window dimensions: large mazes are scaled down to fit
+const unsigned MAX_WINDOW_SIZE = (DEFAULT_MAZE_WIDTH * 2 + 1) * CELL_SIZE;
 
 // Grid cell types
 const int CELL_EMPTY = 0;
 const int CELL_WALL = 1;
 
+// Maze memory layouts
+enum class GridLayout {
+    ROW_MAJOR,  // Rows one after another
+    TILED,      // 8x8 cache-line tiles
+    MORTON      // Z-order inside 64x64 blocks
+};
+
+// Maze generation algorithms (Maze::getGenerators)
+enum class MazeAlgorithm {
+    DFS,      // Recursive backtracker: long winding corridors, few junctions
+    KRUSKAL,  // Randomized Kruskal: many short dead ends, no directional bias
+    PRIM,     // Randomized Prim: short corridors branching out from the center
+    WILSON,   // Loop-erased random walks: uniform spanning tree, unbiased
+    CAVES     // Cellular automaton caves, joined into one area afterwards
+};
+
+// Parallel generation
+const int GENERATION_TILE_CELLS = 128;                  // Logical cells per side of one independently carved tile
+const int PARALLEL_GENERATION_MIN_CELLS = 512 * 512;    // Mazes with at least this many logical cells are carved in tiles
+
+// Open areas and random walls
+const int OPEN_AREA_CELLS_PER_AREA = 400;  // addRandomOpenAreas carves one area per this many grid cells
+const int OPEN_AREA_MIN_SIZE = 3;          // Smallest open area side, in grid cells
+const int OPEN_AREA_MAX_SIZE = 5;          // Largest open area side, in grid cells
+const int RANDOM_WALL_PERCENT = 30;        // Chance of each interior cell being a wall in generateRandomWalls
+const int MAZE_EDIT_LOG_SIZE = 64;         // Edit batches remembered for Maze::getDirtySince
+
+// Cave generation (walls are the automaton's live cells)
+const int CAVE_WALL_PERCENT = 45;                 // Chance of each cell starting as a wall
+const int CAVE_SMOOTHING_STEPS = 5;               // Automaton generations run on the random start
+const std::uint16_t CAVE_BIRTH_MASK = 0x1E0;      // B5678: open cells with 5+ wall neighbors fill in
+const std::uint16_t CAVE_SURVIVE_MASK = 0x1F0;    // S45678: walls with 4+ wall neighbors stay
+
+// Image import (MazeImage)
+const int IMAGE_WALL_LUMINANCE = 128;         // Pixels darker than this (0-255 luma) are wall
+const int IMAGE_MIN_ALPHA = 128;              // Pixels more transparent than this are open
+const int IMAGE_PIXELS_PER_THREAD = 1 << 20;  // Images are split across cores in chunks of at least this many pixels
+
+// Out-of-core distance fields (Pathfinder::buildExternalDistanceField)
+const int EXTERNAL_TILE_CELLS = 1024;       // Side of one square tile; a tile's distances (4 bytes per cell) are resident at a time
+const int EXTERNAL_SPILL_SEEDS = 1 << 16;   // Frontier entries buffered per spill file before they are written or after they are read
+
+// Maze cell classification (Maze analysis pass)
+enum class CellKind : std::uint8_t {
+    WALL,
+    CORRIDOR,   // Two open neighbors
+    JUNCTION,   // Three or four open neighbors
+    DEAD_END,   // At most one open neighbor
+    EXIT        // Open cell on the maze border
+};
+
+// Spawn placement (path distances from the player start)
+const int ENEMY_SPAWN_MIN_DISTANCE = 20;   // Enemies start at least this many steps away
+const int KEY_MIN_DISTANCE = 15;           // The key is placed in a dead end at least this far away
+const int POWERUP_MIN_DISTANCE = 5;        // Power-ups appear at least this many steps from the player
+
 // Player settings
 const float PLAYER_MOVE_DELAY = 0.15f;
 
@@ -37,6 +90,12 @@ enum class EnemyType {
     BEST
 };
 
+// Enemy AI level of detail bands
+enum class AiLod {
+    EXACT,   // Near the player: type-specific pathfinding
+    COARSE   // Far from the player: follows the shared coarse distance field
+};
+
 // Power-up settings
 const sf::Color POWERUP_COLOR = sf::Color(128, 0, 128);  // Purple
 const float GHOST_MODE_DURATION = 3.0f;
@@ -53,6 +112,29 @@ const float ASTAR_ENEMY_DELAY = 0.15f;
 const float DIJKSTRA_ENEMY_DELAY = 0.22f;
 const float BEST_ENEMY_DELAY = 0.10f;  // Faster than player (0.15f)
 
+// Enemy replanning
+const int ENEMY_PATH_VALIDITY_RADIUS = 1;  // Keep a path while it ends within this many cells of the player
+
+// Enemy AI level of detail
+const int ENEMY_LOD_RADIUS = 12;          // Enemies within this many cells of the player use exact pathfinding
+const int ENEMY_LOD_HYSTERESIS = 2;       // Extra distance before a near enemy drops back to coarse movement
+const int COARSE_FIELD_SECTOR_SIZE = 6;   // Far enemies' shared route is refreshed when the player changes sector
+
+// Enemy sight
+const float ENEMY_SIGHT_MEMORY = 6.0f;    // Seconds an enemy keeps chasing after losing sight of the player
+
+// Threat map
+const float THREAT_UNREACHABLE = 1.0e9f;                     // Time-to-reach for cells no enemy can reach
+const float THREAT_OVERLAY_HORIZON = 1.5f;                   // Overlay tints cells reachable within this many seconds
+const sf::Color THREAT_COLOR = sf::Color(255, 0, 0, 110);    // Overlay tint at zero time-to-reach
+const int THREAT_REPAIR_MAX_PERCENT = 20;                     // A move clearing more of a speed layer than this re-expands it in full
+
+// Endless mode
+const int ENDLESS_CHUNK_CELLS = 8;         // Logical cells per chunk side
+const int ENDLESS_DOORS_PER_EDGE = 2;      // Passages opened through each shared chunk edge
+const int ENDLESS_WINDOW_CHUNKS = 3;       // Loaded window around the player, in chunks per side
+const int ENDLESS_CHUNK_CACHE_SIZE = 64;   // Chunks kept in memory (least recently used are evicted)
+
 // Best enemy distraction system
 const float DISTRACTION_DURATION = 3.0f;     // How long distraction lasts
 const float DISTRACTION_COOLDOWN = 8.0f;     // Cooldown between distractions
@@ -7,10 +7,8 @@
 #include "Maze.h"
 #include "Pathfinder.h"
 
-const int Enemy::PATH_UPDATE_INTERVAL = 3;  // Recalculate path every 3 moves
-
 Enemy::Enemy(const Maze& maze, Pathfinder& pathfinder, EnemyType type)
-    : Character(0, 0, ENEMY_COLOR), m_maze(maze), m_pathfinder(pathfinder), m_type(type), m_pathIndex(0), m_movesSincePathUpdate(0), m_targetX(0), m_targetY(0), m_isDistracted(false), m_distractionTimer(0.0f), m_distractionCooldown(0.0f) {
+    : Character(0, 0, ENEMY_COLOR), m_maze(maze), m_pathfinder(pathfinder), m_type(type), m_pathIndex(0), m_playerCellChanged(false), m_pathFailed(false), m_pathVersion(0), m_lod(AiLod::EXACT), m_lodSwitches(0), m_pathSearches(0), m_coarseSteps(0), m_sightMemory(0.0f), m_prevX(-1), m_prevY(-1), m_guardX(-1), m_guardY(-1), m_guardStale(false), m_guarding(false), m_targetX(0), m_targetY(0), m_isDistracted(false), m_distractionTimer(0.0f), m_distractionCooldown(0.0f) {
     switch (m_type) {
         case EnemyType::ASTAR:
             setColor(ASTAR_ENEMY_COLOR);
@@ -29,10 +27,8 @@ Enemy::Enemy(const Maze& maze, Pathfinder& pathfinder, EnemyType type)
     // Initialize random move behavior with some variation
     std::random_device rd;
     std::mt19937 rng(rd());
-    std::uniform_int_distribution<int> intervalDist(2, 5);
     std::uniform_real_distribution<float> chanceDist(0.1f, 0.2f);
 
-    m_pathUpdateInterval = intervalDist(rng);
     m_randomMoveChance = chanceDist(rng);
     m_randomMoveCounter = 0;
 
@@ -47,15 +43,40 @@ void Enemy::update(float deltaTime, int playerX, int playerY, const Maze& maze)
                 m_isDistracted = false;
                 m_distractionTimer = 0.0f;
                 m_distractionCooldown = DISTRACTION_COOLDOWN;
+
+                // Drop the distraction path so the chase resumes immediately
+                m_path.clear();
+                m_pathIndex = 0;
+                m_pathFailed = false;
             }
         } else {
             m_distractionCooldown -= deltaTime;
         }
     }
+
+    // Sight gates chasing: a bit of memory keeps the chase going around corners
+    if (maze.hasLineOfSight(getX(), getY(), playerX, playerY)) {
+        m_sightMemory = ENEMY_SIGHT_MEMORY;
+    } else {
+        m_sightMemory = std::max(0.0f, m_sightMemory - deltaTime);
+    }
         
     if (m_moveTimer.getElapsedTime().asSeconds() < m_moveDelay)
         return;
 
+    updateLod(playerX, playerY);
+
+    // Edits only cost a search when they closed a cell on the remaining path
+    if (maze.getVersion() != m_pathVersion) {
+        if (isPathBlockedByEdits(maze)) {
+            m_path.clear();
+            m_pathIndex = 0;
+        }
+        m_pathFailed = false;  // An opened wall may have made the target reachable
+        m_pathVersion = maze.getVersion();
+        m_guardStale = true;   // Edits move the chokepoints
+    }
+
     // All enemies have a small chance for random moves
     float randomChance = 0.15f;
     
@@ -64,10 +85,54 @@ void Enemy::update(float deltaTime, int playerX, int playerY, const Maze& maze)
         setPosition(randomPos.first, randomPos.second);
         advanceAnimation();
         m_randomMoveCounter++;
+
+        // Stepping off the path invalidates it
+        m_path.clear();
+        m_pathIndex = 0;
+        m_pathFailed = false;
+    } else if (m_lod == AiLod::COARSE && !m_isDistracted) {
+        // Far away: follow the shared coarse route, seen or not; sight only gates the exact search
+        auto step = m_pathfinder.coarseStep(getX(), getY(), playerX, playerY, maze);
+        if (step.first != getX() || step.second != getY()) {
+            setPosition(step.first, step.second);
+            advanceAnimation();
+            m_coarseSteps++;
+        }
+    } else if (!isChasing() && !m_isDistracted && guardChokepoint(playerX, playerY, maze)) {
+        // Player not seen: the Dijkstra enemy holds a chokepoint on the player's route
+    } else if (!isChasing() && !m_isDistracted) {
+        // Player not seen: wander the corridors without searching
+        auto next = getWanderCell(maze);
+        m_prevX = getX();
+        m_prevY = getY();
+        setPosition(next.first, next.second);
+        advanceAnimation();
+
+        m_path.clear();
+        m_pathIndex = 0;
+        m_pathFailed = false;
     } else {
+        // A path to the guard post doesn't lead to the player
+        if (m_guarding) {
+            m_guarding = false;
+            m_path.clear();
+            m_pathIndex = 0;
+            m_pathFailed = false;
+        }
 
-        // need to recalculate?
-        bool needsRecalculation = m_path.empty() || m_pathIndex >= m_path.size() || m_movesSincePathUpdate >= m_pathUpdateInterval;
+        // A ghosted player inside a wall is chased to the nearest open cell
+        auto [chaseX, chaseY] = maze.snapToOpen(playerX, playerY);
+
+        // need to recalculate? only when the path ran out, or the player moved away from its end
+        bool needsRecalculation;
+        if (m_path.empty() || m_pathIndex >= m_path.size()) {
+            // A failed search is only retried once the player moves
+            needsRecalculation = !m_pathFailed || m_playerCellChanged;
+        } else {
+            bool chasingPlayer = !(m_type == EnemyType::BEST && m_isDistracted);
+            needsRecalculation = chasingPlayer && m_playerCellChanged && !isPathValid(chaseX, chaseY);
+        }
+        m_playerCellChanged = false;
         
         // Best enemy distraction system
         if (m_type == EnemyType::BEST && !m_isDistracted && m_distractionCooldown <= 0.0f) {
@@ -79,34 +144,31 @@ void Enemy::update(float deltaTime, int playerX, int playerY, const Maze& maze)
                 std::uniform_real_distribution<float> distractionChance(0.0f, 1.0f);
                 
                 if (distractionChance(rng) < DISTRACTION_CHANCE) {
-                    std::uniform_int_distribution<int> randomX(1, GRID_WIDTH - 2);
-                    std::uniform_int_distribution<int> randomY(1, GRID_HEIGHT - 2);
-                    
-                    int attempts = 0;
-                    do {
-                        m_targetX = randomX(rng);
-                        m_targetY = randomY(rng);
-                        attempts++;
-                    } while (maze.isWall(m_targetX, m_targetY) && attempts < 50);
-                    
-                    if (attempts < 50) {  
-                        m_isDistracted = true;
-                        m_distractionTimer = DISTRACTION_DURATION;
-                        needsRecalculation = true;
-                    }
+                    std::uniform_int_distribution<int> randomX(1, maze.getGridWidth() - 2);
+                    std::uniform_int_distribution<int> randomY(1, maze.getGridHeight() - 2);
+
+                    // Any random cell snaps straight to an open one, no rejection sampling
+                    auto target = maze.snapToOpen(randomX(rng), randomY(rng));
+                    m_targetX = target.first;
+                    m_targetY = target.second;
+
+                    m_isDistracted = true;
+                    m_distractionTimer = DISTRACTION_DURATION;
+                    needsRecalculation = true;
                 }
             }
         }
         
         if (needsRecalculation) {
             if (m_type == EnemyType::BEST && !m_isDistracted) {
-                m_targetX = playerX;
-                m_targetY = playerY;
+                m_targetX = chaseX;
+                m_targetY = chaseY;
             } else if (m_type != EnemyType::BEST) {
-                m_targetX = playerX;
-                m_targetY = playerY;
+                m_targetX = chaseX;
+                m_targetY = chaseY;
             }
             // Use different pathfinding based on enemy type
+            m_pathSearches++;
             switch (m_type) {
                 case EnemyType::ASTAR:
                     m_path = m_pathfinder.findPath(getX(), getY(), m_targetX, m_targetY, maze);
@@ -119,7 +181,7 @@ void Enemy::update(float deltaTime, int playerX, int playerY, const Maze& maze)
                     break;
             }
             m_pathIndex = 0;
-            m_movesSincePathUpdate = 0;
+            m_pathFailed = m_path.empty();
 
             // If no path found, don't move
             if (m_path.empty()) {
@@ -132,13 +194,198 @@ void Enemy::update(float deltaTime, int playerX, int playerY, const Maze& maze)
             setPosition(m_path[m_pathIndex].first, m_path[m_pathIndex].second);
             advanceAnimation();
             m_pathIndex++;
-            m_movesSincePathUpdate++;
         }
     }
 
     m_moveTimer.restart();
 }
 
+void Enemy::updateLod(int playerX, int playerY) {
+    int distanceFromPlayer = Pathfinder::manhattanDistance(getX(), getY(), playerX, playerY);
+
+    AiLod newLod = m_lod;
+    if (m_lod == AiLod::EXACT && distanceFromPlayer > ENEMY_LOD_RADIUS + ENEMY_LOD_HYSTERESIS) {
+        newLod = AiLod::COARSE;
+    } else if (m_lod == AiLod::COARSE && distanceFromPlayer <= ENEMY_LOD_RADIUS) {
+        newLod = AiLod::EXACT;
+    }
+
+    if (newLod != m_lod) {
+        m_lod = newLod;
+        m_lodSwitches++;
+
+        // Exact pathing starts from a fresh search
+        m_path.clear();
+        m_pathIndex = 0;
+        m_pathFailed = false;
+    }
+}
+
+void Enemy::onPlayerCellChanged() {
+    m_playerCellChanged = true;
+    m_guardStale = true;
+}
+
+void Enemy::setGoals(const std::vector<std::pair<int, int>>& goals) {
+    m_goals = goals;
+    m_guardStale = true;
+}
+
+bool Enemy::guardChokepoint(int playerX, int playerY, const Maze& maze) {
+    if (m_type != EnemyType::DIJKSTRA || m_goals.empty()) {
+        return false;
+    }
+
+    int oldGuardX = m_guardX;
+    int oldGuardY = m_guardY;
+    if (m_guardStale) {
+        chooseGuardPost(playerX, playerY, maze);
+        m_guardStale = false;
+    }
+    if (m_guardX < 0) {
+        m_guarding = false;
+        return false;
+    }
+
+    bool atPost = getX() == m_guardX && getY() == m_guardY;
+    bool pathDone = m_path.empty() || m_pathIndex >= m_path.size();
+    bool postMoved = m_guardX != oldGuardX || m_guardY != oldGuardY;
+
+    // A post further back along the current path just shortens it
+    if (m_guarding && postMoved && !pathDone) {
+        auto onPath = std::find(m_path.begin() + m_pathIndex, m_path.end(), std::make_pair(m_guardX, m_guardY));
+        if (onPath != m_path.end()) {
+            m_path.erase(onPath + 1, m_path.end());
+            m_targetX = m_guardX;
+            m_targetY = m_guardY;
+            postMoved = false;
+        }
+    }
+    if (!m_guarding || postMoved || (pathDone && !atPost)) {
+        m_guarding = true;
+        m_targetX = m_guardX;
+        m_targetY = m_guardY;
+        m_path.clear();
+        m_pathIndex = 0;
+        if (!atPost) {
+            m_pathSearches++;
+            m_path = m_pathfinder.findPathDijkstra(getX(), getY(), m_guardX, m_guardY, maze);
+            if (m_path.empty()) {
+                // Unreachable post: wander until the player or the maze changes
+                m_guardX = -1;
+                m_guardY = -1;
+                m_guarding = false;
+                return false;
+            }
+        }
+    }
+
+    if (m_pathIndex < m_path.size()) {
+        setPosition(m_path[m_pathIndex].first, m_path[m_pathIndex].second);
+        advanceAnimation();
+        m_pathIndex++;
+    }
+    return true;
+}
+
+void Enemy::chooseGuardPost(int playerX, int playerY, const Maze& maze) {
+    m_guardX = -1;
+    m_guardY = -1;
+    auto [fromX, fromY] = maze.snapToOpen(playerX, playerY);
+
+    // Routes to different goals share their chokepoints up to where they part
+    std::vector<std::pair<int, int>> common;
+    std::vector<std::pair<int, int>> chokepoints;
+    bool first = true;
+    for (const auto& goal : m_goals) {
+        if (!maze.getChokepoints(fromX, fromY, goal.first, goal.second, chokepoints)) {
+            continue;  // Unreachable goals don't constrain the player
+        }
+        if (first) {
+            common = chokepoints;
+            first = false;
+            continue;
+        }
+        size_t shared = 0;
+        while (shared < common.size() && shared < chokepoints.size() && common[shared] == chokepoints[shared]) {
+            shared++;
+        }
+        common.resize(shared);
+    }
+    if (common.empty()) {
+        return;
+    }
+
+    auto post = common.back();
+    for (const auto& cell : common) {
+        if (Pathfinder::manhattanDistance(getX(), getY(), cell.first, cell.second) <
+            Pathfinder::manhattanDistance(fromX, fromY, cell.first, cell.second)) {
+            post = cell;
+            break;
+        }
+    }
+    m_guardX = post.first;
+    m_guardY = post.second;
+}
+
+void Enemy::onWindowShifted(int dx, int dy) {
+    int newX = getX() + dx;
+    int newY = getY() + dy;
+
+    if (m_maze.isValidPosition(newX, newY)) {
+        for (auto& step : m_path) {
+            step.first += dx;
+            step.second += dy;
+        }
+        m_prevX += dx;
+        m_prevY += dy;
+        m_targetX += dx;
+        m_targetY += dy;
+        m_guardStale = true;
+        setPosition(newX, newY);
+        return;
+    }
+
+    // Fell out of the window: trail in from the edge closest to where it was
+    newX = std::max(0, std::min(newX, m_maze.getGridWidth() - 1));
+    newY = std::max(0, std::min(newY, m_maze.getGridHeight() - 1));
+    auto entry = m_maze.snapToOpen(newX, newY);
+    m_path.clear();
+    m_pathIndex = 0;
+    m_guardStale = true;
+    m_prevX = entry.first;
+    m_prevY = entry.second;
+    setPosition(entry.first, entry.second);
+}
+
+bool Enemy::isPathValid(int playerX, int playerY) const {
+    if (m_path.empty() || m_pathIndex >= m_path.size()) {
+        return false;
+    }
+
+    const auto& pathEnd = m_path.back();
+    return Pathfinder::manhattanDistance(pathEnd.first, pathEnd.second, playerX, playerY) <= ENEMY_PATH_VALIDITY_RADIUS;
+}
+
+bool Enemy::isPathBlockedByEdits(const Maze& maze) const {
+    if (m_path.empty() || m_pathIndex >= m_path.size()) {
+        return false;
+    }
+
+    Maze::DirtyRegion region;
+    if (!maze.getDirtySince(m_pathVersion, region)) {
+        return true;
+    }
+
+    for (size_t i = m_pathIndex; i < m_path.size(); ++i) {
+        const auto& cell = m_path[i];
+        if (region.contains(cell.first, cell.second) && maze.isWall(cell.first, cell.second)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool Enemy::hasCaughtPlayer(int playerX, int playerY) const {
     return getX() == playerX && getY() == playerY;
 }
@@ -164,8 +411,8 @@ void Enemy::updateSpeedForRound(int roundNumber) {
 std::pair<int, int> Enemy::findRandomSpawnLocation(const Maze& maze, int playerX, int playerY) {
     std::random_device rd;
     std::mt19937 rng(rd());
-    std::uniform_int_distribution<int> xDist(1, GRID_WIDTH - 2);
-    std::uniform_int_distribution<int> yDist(1, GRID_HEIGHT - 2);
+    std::uniform_int_distribution<int> xDist(1, maze.getGridWidth() - 2);
+    std::uniform_int_distribution<int> yDist(1, maze.getGridHeight() - 2);
 
     int attempts = 0;
     const int maxAttempts = 100;
@@ -185,11 +432,11 @@ std::pair<int, int> Enemy::findRandomSpawnLocation(const Maze& maze, int playerX
     }
 
     // Fallback: spawn at any empty cell (excluding center)
-    for (int y = 1; y < GRID_HEIGHT - 1; ++y) {
-        for (int x = 1; x < GRID_WIDTH - 1; ++x) {
+    for (int y = 1; y < maze.getGridHeight() - 1; ++y) {
+        for (int x = 1; x < maze.getGridWidth() - 1; ++x) {
             if (maze.isValidPosition(x, y) && !maze.isWall(x, y)) {
                 // Avoid spawning at center where player starts
-                if (x != GRID_WIDTH / 2 || y != GRID_HEIGHT / 2) {
+                if (x != maze.getGridWidth() / 2 || y != maze.getGridHeight() / 2) {
                     return {x, y};
                 }
             }
@@ -197,7 +444,7 @@ std::pair<int, int> Enemy::findRandomSpawnLocation(const Maze& maze, int playerX
     }
 
     // Last resort: spawn at center
-    return {GRID_WIDTH / 2, GRID_HEIGHT / 2};
+    return {maze.getGridWidth() / 2, maze.getGridHeight() / 2};
 }
 
 bool Enemy::shouldMakeRandomMove(float chance) const {
@@ -221,7 +468,7 @@ std::pair<int, int> Enemy::getRandomAdjacentCell(const Maze& maze) const {
         int newX = currentX + directions[i][0];
         int newY = currentY + directions[i][1];
 
-        if (maze.isValidPosition(newX, newY) && !maze.isWall(newX, newY)) {
+        if (!maze.isWallUnchecked(newX, newY)) {
             validMoves.push_back({newX, newY});
         }
     }
@@ -238,6 +485,34 @@ std::pair<int, int> Enemy::getRandomAdjacentCell(const Maze& maze) const {
 
 
 
+std::pair<int, int> Enemy::getWanderCell(const Maze& maze) const {
+    std::vector<std::pair<int, int>> validMoves;
+    int currentX = getX();
+    int currentY = getY();
+
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    for (int i = 0; i < 4; ++i) {
+        int newX = currentX + directions[i][0];
+        int newY = currentY + directions[i][1];
+
+        if (!maze.isWallUnchecked(newX, newY) &&
+            (newX != m_prevX || newY != m_prevY)) {
+            validMoves.push_back({newX, newY});
+        }
+    }
+
+    // Dead end: turning back is the only option
+    if (validMoves.empty()) {
+        return getRandomAdjacentCell(maze);
+    }
+
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::uniform_int_distribution<int> dist(0, validMoves.size() - 1);
+    return validMoves[dist(rng)];
+}
+
 void Enemy::calculateTarget(int playerX, int playerY) {
     m_targetX = playerX;
     m_targetY = playerY;
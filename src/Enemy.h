@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
 
 #include "Character.h"
@@ -38,9 +39,43 @@ class Enemy : public Character {
      * @param maze Reference to the maze for pathfinding
      *
      * Handles movement timing, path following, and path recalculation.
+     * Far (coarse LOD) enemies follow the shared coarse route. Near ones
+     * only search for the player while they can see them down a corridor
+     * (or saw them within ENEMY_SIGHT_MEMORY seconds) and wander otherwise.
+     * The current path is only replanned when it runs out or, after the
+     * player changes cell, when it no longer ends near the player.
      */
     void update(float deltaTime, int playerX, int playerY, const Maze& maze);
 
+    /**
+     * @brief Notifies the enemy that the player has moved to a new cell
+     *
+     * Called by Game only when the player's cell changes, so an idle
+     * player never causes a replan.
+     */
+    void onPlayerCellChanged();
+
+    /**
+     * @brief Tells the enemy where the player is heading
+     *
+     * @param goals The key, or the exits once it is collected (empty = none)
+     *
+     * The Dijkstra enemy uses it to guard a chokepoint on the player's
+     * route while it can't see the player.
+     */
+    void setGoals(const std::vector<std::pair<int, int>>& goals);
+
+    /**
+     * @brief Moves the enemy along with a scrolled endless-mode window
+     *
+     * @param dx Grid X offset to apply (new window coordinates minus old)
+     * @param dy Grid Y offset to apply
+     *
+     * Keeps the current path if the enemy is still inside the window;
+     * otherwise it re-enters at the nearest open cell on the window edge.
+     */
+    void onWindowShifted(int dx, int dy);
+
     /**
      * @brief Checks if the enemy has caught the player
      *
@@ -57,7 +92,59 @@ class Enemy : public Character {
      */
     void updateSpeedForRound(int roundNumber);
 
+    /**
+     * @brief Gets the enemy's delay between moves
+     *
+     * @return Seconds per move
+     */
+    float getMoveDelay() const { return m_moveDelay; }
+
+    /**
+     * @brief Gets the enemy's current AI level-of-detail band
+     *
+     * @return EXACT when near the player, COARSE when far away
+     */
+    AiLod getLod() const { return m_lod; }
+
+    /**
+     * @brief Gets the number of times the enemy switched LOD band
+     *
+     * @return LOD switch count
+     */
+    int getLodSwitchCount() const { return m_lodSwitches; }
+
+    /**
+     * @brief Gets the number of exact pathfinding searches the enemy ran
+     *
+     * @return Search count
+     */
+    int getPathSearchCount() const { return m_pathSearches; }
+
+    /**
+     * @brief Gets the number of moves made along the coarse route
+     *
+     * @return Coarse step count
+     */
+    int getCoarseStepCount() const { return m_coarseSteps; }
+
+    /**
+     * @brief Checks if the enemy is chasing (has seen the player recently)
+     *
+     * @return true if chasing, false if wandering
+     */
+    bool isChasing() const { return m_sightMemory > 0.0f; }
+
    private:
+    /**
+     * @brief Updates the LOD band from the distance to the player
+     *
+     * @param playerX Player's X position
+     * @param playerY Player's Y position
+     *
+     * Uses ENEMY_LOD_HYSTERESIS so enemies on the boundary don't flicker between bands.
+     */
+    void updateLod(int playerX, int playerY);
+
     /**
      * @brief Finds a random empty spawn location
      *
@@ -84,7 +171,57 @@ class Enemy : public Character {
      */
     std::pair<int, int> getRandomAdjacentCell(const Maze& maze) const;
 
+    /**
+     * @brief Gets the next cell when wandering along corridors
+     *
+     * @param maze Reference to the maze for collision checking
+     * @return Random adjacent open cell, avoiding turning back unless at a dead end
+     */
+    std::pair<int, int> getWanderCell(const Maze& maze) const;
+
+    /**
+     * @brief Checks if the current path still leads to the player
+     *
+     * @param playerX Player's X position
+     * @param playerY Player's Y position
+     * @return true if the remaining path ends within ENEMY_PATH_VALIDITY_RADIUS of the player
+     */
+    bool isPathValid(int playerX, int playerY) const;
+
+    /**
+     * @brief Checks if maze edits since the path was planned walled off a cell still ahead on it
+     *
+     * @param maze Reference to the maze
+     * @return true if the path must be replanned (also when the edits are unknown)
+     */
+    bool isPathBlockedByEdits(const Maze& maze) const;
+
 
+    /**
+     * @brief Moves the Dijkstra enemy toward its guard post, or holds it
+     *
+     * @param playerX Player's X position
+     * @param playerY Player's Y position
+     * @param maze Reference to the maze
+     * @return false if this enemy has no post to guard (it wanders instead)
+     *
+     * Searches only when the post changes or the path runs out.
+     */
+    bool guardChokepoint(int playerX, int playerY, const Maze& maze);
+
+    /**
+     * @brief Picks the chokepoint to guard between the player and the goals
+     *
+     * @param playerX Player's X position
+     * @param playerY Player's Y position
+     * @param maze Reference to the maze
+     *
+     * Only cells on every route to every goal count (the shared prefix of
+     * Maze::getChokepoints per goal). Intercepts at the first of them the
+     * enemy is closer to than the player, otherwise guards the one nearest
+     * the goals. Run only after the player changes cell or the maze changes.
+     */
+    void chooseGuardPost(int playerX, int playerY, const Maze& maze);
 
     /**
      * @brief Calculates target position based on Pac-Man style behavior
@@ -103,11 +240,27 @@ class Enemy : public Character {
     float m_moveDelay;                        ///< Delay between moves (type-specific)
     std::vector<std::pair<int, int>> m_path;  ///< Current path to player
     int m_pathIndex;                          ///< Current position in path
-    int m_movesSincePathUpdate;               ///< Counter for path recalculation
-    int m_pathUpdateInterval;                 ///< Individual path update interval (2-5)
+    bool m_playerCellChanged;                 ///< Player moved since the path was last validated
+    bool m_pathFailed;                        ///< Last search found no path to the current target
+    std::uint64_t m_pathVersion;              ///< Maze version the path was last checked against
     float m_randomMoveChance;                 ///< Chance to make random move (0.15 = 15%)
     int m_randomMoveCounter;                  ///< Counter for random moves
-    static const int PATH_UPDATE_INTERVAL;    ///< Recalculate path every N moves
+
+    // Level of detail
+    AiLod m_lod;                              ///< Current AI level-of-detail band
+    int m_lodSwitches;                        ///< Number of LOD band switches
+    int m_pathSearches;                       ///< Number of exact pathfinding searches
+    int m_coarseSteps;                        ///< Number of coarse route moves
+
+    // Sight
+    float m_sightMemory;                      ///< Seconds of chasing left since the player was last seen
+    int m_prevX, m_prevY;                     ///< Previous cell while wandering (to avoid turning back)
+
+    // Guarding (Dijkstra enemy only)
+    std::vector<std::pair<int, int>> m_goals;  ///< Cells the player is heading for
+    int m_guardX, m_guardY;                   ///< Chokepoint to guard (-1 = none)
+    bool m_guardStale;                        ///< Player, goals or maze changed since the post was chosen
+    bool m_guarding;                          ///< Current path leads to the guard post
 
 
     // Target tracking
@@ -1,10 +1,11 @@
 #include "Game.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 
-Game::Game()
-    : m_window(sf::VideoMode(sf::Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT)), "Oubliette - Maze Chase Game"), m_player(GRID_WIDTH / 2, GRID_HEIGHT / 2), m_pathfinder(), m_key(nullptr), m_hasKey(false), m_currentRound(1), m_gameOver(false), m_roundTransition(false), m_transitionTimer(0.0f), m_roundText(m_font) {
+Game::Game(int mazeWidth, int mazeHeight, bool endless, MazeAlgorithm algorithm, const Maze* arena)
+    : m_window(sf::VideoMode(windowSizeForMaze(mazeWidth, mazeHeight)), "Oubliette - Maze Chase Game"), m_player(0, 0), m_maze(Maze::placeholder(mazeWidth, mazeHeight, algorithm)), m_nextMaze(Maze::placeholder(mazeWidth, mazeHeight, algorithm)), m_chunks(endless ? std::make_unique<ChunkCache>(Maze::randomSeed()) : nullptr), m_arena(arena ? std::make_unique<Maze>(*arena) : nullptr), m_pathfinder(), m_key(nullptr), m_hasKey(false), m_currentRound(1), m_gameOver(false), m_showThreatOverlay(false), m_rng(Maze::randomSeed()), m_roundTransition(false), m_transitionTimer(0.0f), m_roundText(m_font) {
     if (!m_font.openFromFile("C:/Windows/Fonts/arial.ttf")) {
         std::cout << "Warning: Could not load font, using default" << std::endl;
     }
@@ -14,6 +15,8 @@ Game::Game()
     m_roundText.setFillColor(sf::Color::White);
     m_roundText.setStyle(sf::Text::Bold);
 
+    m_player.setPosition(m_maze.getGridWidth() / 2, m_maze.getGridHeight() / 2);
+
     // Load textures
     if (!loadTextures()) {
         std::cout << "Warning: Could not load animation textures, using colored shapes" << std::endl;
@@ -25,9 +28,6 @@ Game::Game()
         std::cout << "Warning: Could not load round background texture from src/assets/round.png" << std::endl;
     } else {
         m_roundBackgroundSprite = std::make_unique<sf::Sprite>(m_roundBackgroundTexture);
-        float scaleX = static_cast<float>(WINDOW_WIDTH) / m_roundBackgroundTexture.getSize().x;
-        float scaleY = static_cast<float>(WINDOW_HEIGHT) / m_roundBackgroundTexture.getSize().y;
-        m_roundBackgroundSprite->setScale(sf::Vector2f(scaleX, scaleY));
     }
 
     // Load game over texture
@@ -35,9 +35,6 @@ Game::Game()
         std::cout << "Warning: Could not load game over texture from src/assets/game-over.png" << std::endl;
     } else {
         m_gameOverSprite = std::make_unique<sf::Sprite>(m_gameOverTexture);
-        float scaleX = static_cast<float>(WINDOW_WIDTH) / m_gameOverTexture.getSize().x;
-        float scaleY = static_cast<float>(WINDOW_HEIGHT) / m_gameOverTexture.getSize().y;
-        m_gameOverSprite->setScale(sf::Vector2f(scaleX, scaleY));
     }
 
     if (!m_keyTexture1.loadFromFile("src/assets/key1.png") || !m_keyTexture2.loadFromFile("src/assets/key2.png")) {
@@ -48,6 +45,7 @@ Game::Game()
         std::cout << "Warning: Could not load ghost animation textures, using default shape" << std::endl;
     }
 
+    updateView();
     startNewRound();
 }
 
@@ -69,12 +67,19 @@ void Game::processEvents() {
         if (event->is<sf::Event::Closed>()) {
             m_window.close();
         }
+
+        if (event->is<sf::Event::Resized>()) {
+            updateView();
+        }
         
         if (event->is<sf::Event::KeyPressed>()) {
             const auto& keyEvent = event->getIf<sf::Event::KeyPressed>();
             if (keyEvent && keyEvent->code == sf::Keyboard::Key::Space && m_gameOver) {
                 restartGame();
             }
+            if (keyEvent && keyEvent->code == sf::Keyboard::Key::T) {
+                m_showThreatOverlay = !m_showThreatOverlay;
+            }
         }
     }
 }
@@ -89,9 +94,21 @@ void Game::update(float deltaTime) {
         return;
     }
 
+    int oldPlayerX = m_player.getX();
+    int oldPlayerY = m_player.getY();
     m_player.handleInput(m_maze, m_hasKey);
     m_player.updateGhostMode(deltaTime);
 
+    // Publish player cell changes so enemies only revalidate their paths when needed
+    if (m_player.getX() != oldPlayerX || m_player.getY() != oldPlayerY) {
+        if (m_chunks) {
+            scrollEndlessWindow();
+        }
+        for (auto& enemy : m_enemies) {
+            enemy.onPlayerCellChanged();
+        }
+    }
+
     if (m_key) {
         m_key->update(deltaTime);
     }
@@ -115,7 +132,10 @@ void Game::update(float deltaTime) {
         enemy.update(deltaTime, m_player.getX(), m_player.getY(), m_maze);
     }
 
+    m_threatMap.update(m_enemies, m_maze);
+
     if (checkWinCondition()) {
+        logAiStats();
         std::cout << "Congratulations! You escaped the maze! Starting round " << (m_currentRound + 1) << "..." << std::endl;
         m_currentRound++;
         startNewRound();
@@ -123,15 +143,21 @@ void Game::update(float deltaTime) {
 
     if (checkGameOverCondition()) {
         m_gameOver = true;
+        logAiStats();
         std::cout << "Game Over! The enemy caught you! Press SPACE to restart." << std::endl;
     }
 }
 
 void Game::render() {
     m_window.clear(sf::Color::Black);
+    m_window.setView(m_worldView);
 
     m_maze.render(m_window);
 
+    if (m_showThreatOverlay) {
+        m_threatMap.render(m_window);
+    }
+
     if (m_key && !m_hasKey) {
         m_key->render(m_window);
     }
@@ -146,13 +172,17 @@ void Game::render() {
 
     m_player.render(m_window);
 
+    // Full-screen overlays are drawn in window coordinates
+    m_window.setView(m_screenView);
+    sf::Vector2f screenSize(static_cast<float>(m_window.getSize().x), static_cast<float>(m_window.getSize().y));
+
     // Round transition screen
     if (m_roundTransition) {
         if (m_roundBackgroundSprite) {
             m_window.draw(*m_roundBackgroundSprite);
         } else {
             sf::RectangleShape blackOverlay;
-            blackOverlay.setSize(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+            blackOverlay.setSize(screenSize);
             blackOverlay.setFillColor(sf::Color::Black);
             m_window.draw(blackOverlay);
         }
@@ -166,7 +196,7 @@ void Game::render() {
         } else {
             // Fallback: black background 
             sf::RectangleShape blackOverlay;
-            blackOverlay.setSize(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+            blackOverlay.setSize(screenSize);
             blackOverlay.setFillColor(sf::Color::Black);
             m_window.draw(blackOverlay);
         }
@@ -177,8 +207,7 @@ void Game::render() {
 
 bool Game::checkWinCondition() const {
     if (!m_hasKey) return false;
-    return m_player.getX() < 0 || m_player.getX() >= GRID_WIDTH ||
-           m_player.getY() < 0 || m_player.getY() >= GRID_HEIGHT;
+    return !m_maze.isValidPosition(m_player.getX(), m_player.getY());
 }
 
 bool Game::checkGameOverCondition() const {
@@ -200,64 +229,30 @@ void Game::checkKeyCollection() {
     if (m_player.getX() == m_key->getX() && m_player.getY() == m_key->getY()) {
         m_hasKey = true;
         std::cout << "Key collected! You can now escape through the brown exits!" << std::endl;
+        updateEnemyGoals();
     }
 }
 
-void Game::spawnEnemiesForRound(int roundNumber) {
-    std::vector<std::pair<int, int>> usedPositions;
-    std::vector<std::pair<int, int>> validSpawnPositions;
-
-    usedPositions.push_back({m_player.getX(), m_player.getY()});
-
-    for (int y = 1; y < GRID_HEIGHT - 1; ++y) {
-        for (int x = 1; x < GRID_WIDTH - 1; ++x) {
-            if (!m_maze.isWall(x, y)) {
-                int distFromPlayer = std::abs(x - m_player.getX()) + std::abs(y - m_player.getY());
-                if (distFromPlayer >= 10) {
-                    int distFromLeftEdge = x;
-                    int distFromRightEdge = GRID_WIDTH - 1 - x;
-                    int distFromTopEdge = y;
-                    int distFromBottomEdge = GRID_HEIGHT - 1 - y;
-
-                    int minDistToEdge = std::min({distFromLeftEdge, distFromRightEdge,
-                                                  distFromTopEdge, distFromBottomEdge});
-
-                    if (minDistToEdge <= 3) {
-                        validSpawnPositions.push_back({x, y});
-                    }
-                }
-            }
-        }
+void Game::updateEnemyGoals() {
+    std::vector<std::pair<int, int>> goals;
+    if (m_key && !m_hasKey) {
+        goals.push_back(m_key->getPosition());
+    } else if (!m_chunks) {
+        goals = m_maze.getExits();
     }
+    for (auto& enemy : m_enemies) {
+        enemy.setGoals(goals);
+    }
+}
 
+void Game::spawnEnemiesForRound(int roundNumber, const std::vector<std::pair<int, int>>& spawnPositions) {
     std::vector<EnemyType> enemyTypes = {EnemyType::ASTAR, EnemyType::DIJKSTRA, EnemyType::BEST};
 
-    for (EnemyType type : enemyTypes) {
-        std::random_device rd;
-        std::mt19937 rng(rd());
-
-        int attempts = 0;
-        int enemyX, enemyY;
-        bool validSpawn = false;
-
-        std::shuffle(validSpawnPositions.begin(), validSpawnPositions.end(), rng);
-
-        for (const auto& pos : validSpawnPositions) {
-            bool positionUsed = false;
-            for (const auto& usedPos : usedPositions) {
-                if (pos.first == usedPos.first && pos.second == usedPos.second) {
-                    positionUsed = true;
-                    break;
-                }
-            }
-
-            if (!positionUsed) {
-                enemyX = pos.first;
-                enemyY = pos.second;
-                validSpawn = true;
-                break;
-            }
-        }
+    for (size_t i = 0; i < enemyTypes.size() && i < spawnPositions.size(); ++i) {
+        EnemyType type = enemyTypes[i];
+        int enemyX = spawnPositions[i].first;
+        int enemyY = spawnPositions[i].second;
+        bool validSpawn = enemyX >= 0;
 
         if (validSpawn) {
             m_enemies.emplace_back(m_maze, m_pathfinder, type);
@@ -275,8 +270,6 @@ void Game::spawnEnemiesForRound(int roundNumber) {
                     m_enemies.back().setAnimationTextures(m_bestTexture1, m_bestTexture2);
                     break;
             }
-
-            usedPositions.push_back({enemyX, enemyY});
         }
     }
 }
@@ -287,10 +280,15 @@ void Game::startRoundTransition() {
 
     m_roundText.setString(std::to_string(m_currentRound));
 
+    // Build the next maze while the round screen shows (a pending build from an interrupted transition is reused)
+    if (!m_nextRound.valid()) {
+        m_nextRound = std::async(std::launch::async, &Game::prepareRound, this);
+    }
+
     sf::FloatRect textRect = m_roundText.getLocalBounds();
     m_roundText.setOrigin(sf::Vector2f(textRect.position.x + textRect.size.x / 2.0f,
                                        textRect.position.y + textRect.size.y / 2.0f));
-    m_roundText.setPosition(sf::Vector2f(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f));
+    m_roundText.setPosition(sf::Vector2f(m_window.getSize().x / 2.0f, m_window.getSize().y / 2.0f));
 }
 
 void Game::updateRoundTransition(float deltaTime) {
@@ -298,16 +296,79 @@ void Game::updateRoundTransition(float deltaTime) {
 
     const float TRANSITION_DURATION = 2.0f;
 
-    if (m_transitionTimer >= TRANSITION_DURATION) {
+    // Hold the round screen a little longer if the next maze isn't ready yet
+    if (m_transitionTimer >= TRANSITION_DURATION &&
+        m_nextRound.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
         m_roundTransition = false;
-        setupRound();
+        setupRound(m_nextRound.get());
+    }
+}
+
+Game::RoundPlan Game::prepareRound() {
+    RoundPlan plan;
+
+    if (m_chunks) {
+        // Start with the window centered on the world origin
+        const std::int64_t chunkSize = ChunkCache::chunkGridSize();
+        m_nextMaze.loadWindow(*m_chunks, -chunkSize * (m_nextMaze.getGridWidth() / chunkSize / 2),
+                              -chunkSize * (m_nextMaze.getGridHeight() / chunkSize / 2));
+    } else if (m_arena) {
+        // Copying shares the arena's cells and tables, so this is as cheap as a swap
+        m_nextMaze = *m_arena;
+    } else {
+        m_nextMaze.regenerate();
     }
+
+    // Placement samples the analysis built by regenerate, reproducibly from the maze seed
+    plan.start = m_nextMaze.getStart();
+    const int farthest = m_nextMaze.getMaxStartDistance();
+    Random rng(Random::mix(m_nextMaze.getSeed()));
+
+    // Key in a dead end well away from the start (endless mode has no key or exits)
+    plan.keyPosition = {-1, -1};
+    if (!m_chunks) {
+        plan.keyPosition = m_nextMaze.sampleByDistance(KEY_MIN_DISTANCE, farthest, CellKind::DEAD_END, rng);
+        if (plan.keyPosition.first < 0) {
+            plan.keyPosition = m_nextMaze.sampleByDistance(std::max(1, farthest / 2), farthest, rng);
+        }
+    }
+
+    // Enemies start far from the player along real paths, on distinct cells
+    const int enemyCount = 3;
+    int enemyMinDistance = ENEMY_SPAWN_MIN_DISTANCE;
+    if (m_nextMaze.countByDistance(enemyMinDistance, farthest) < enemyCount + 1) {
+        enemyMinDistance = std::max(1, farthest / 2);
+    }
+    for (int i = 0; i < enemyCount; ++i) {
+        std::pair<int, int> spawn(-1, -1);
+        for (int attempt = 0; attempt < 8; ++attempt) {
+            spawn = m_nextMaze.sampleByDistance(enemyMinDistance, farthest, rng);
+            bool taken = spawn == plan.keyPosition ||
+                         std::find(plan.enemySpawns.begin(), plan.enemySpawns.end(), spawn) != plan.enemySpawns.end();
+            if (!taken) {
+                break;
+            }
+            spawn = {-1, -1};
+        }
+        plan.enemySpawns.push_back(spawn);
+    }
+
+    // Built into the plan, not m_pathfinder, which the live enemies share
+    plan.pathfinder.prepareCoarseField(plan.start.first, plan.start.second, m_nextMaze);
+
+    return plan;
 }
 
-void Game::setupRound() {
-    m_maze.regenerate();
+void Game::setupRound(RoundPlan plan) {
+    // Swapping the prepared maze in is O(1): no generation happens on this thread
+    std::swap(m_maze, m_nextMaze);
+    m_pathfinder.adoptCoarseField(plan.pathfinder);
+    if (m_chunks) {
+        prefetchAroundWindow();
+    }
+    m_threatMap.reset();
 
-    m_player.setPosition(GRID_WIDTH / 2, GRID_HEIGHT / 2);
+    m_player.setPosition(plan.start.first, plan.start.second);
     m_player.resetGhostMode();
 
     m_hasKey = false;
@@ -317,28 +378,18 @@ void Game::setupRound() {
         m_key = nullptr;
     }
 
-    // Spawn new key at random location
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::uniform_int_distribution<int> xDist(1, GRID_WIDTH - 2);
-    std::uniform_int_distribution<int> yDist(1, GRID_HEIGHT - 2);
-
-    int keyX, keyY;
-    do {
-        keyX = xDist(rng);
-        keyY = yDist(rng);
-    } while (m_maze.isWall(keyX, keyY) ||
-             (keyX == GRID_WIDTH / 2 && keyY == GRID_HEIGHT / 2));
+    if (plan.keyPosition.first >= 0) {
+        m_key = new Key(plan.keyPosition.first, plan.keyPosition.second);
 
-    m_key = new Key(keyX, keyY);
-    
-    if (m_keyTexture1.getSize().x > 0 && m_keyTexture2.getSize().x > 0) {
-        m_key->setAnimationTextures(m_keyTexture1, m_keyTexture2);
+        if (m_keyTexture1.getSize().x > 0 && m_keyTexture2.getSize().x > 0) {
+            m_key->setAnimationTextures(m_keyTexture1, m_keyTexture2);
+        }
     }
 
     m_enemies.clear();
     m_powerups.clear();
-    spawnEnemiesForRound(m_currentRound);
+    spawnEnemiesForRound(m_currentRound, plan.enemySpawns);
+    updateEnemyGoals();
 }
 
 void Game::restartGame() {
@@ -347,7 +398,7 @@ void Game::restartGame() {
     m_roundTransition = false;
     m_transitionTimer = 0.0f;
     
-    m_player.setPosition(GRID_WIDTH / 2, GRID_HEIGHT / 2);
+    m_player.setPosition(m_maze.getGridWidth() / 2, m_maze.getGridHeight() / 2);
     m_player.resetGhostMode();
     
     m_enemies.clear();
@@ -362,37 +413,37 @@ void Game::restartGame() {
 }
 
 void Game::spawnPowerUp() {
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::uniform_int_distribution<int> xDist(1, GRID_WIDTH - 2);
-    std::uniform_int_distribution<int> yDist(1, GRID_HEIGHT - 2);
+    // Start distances bound real distances: |d(start, cell) - d(start, player)| <= d(player, cell),
+    // so cells outside the band around the player's start distance are far enough away
+    auto playerCell = m_maze.snapToOpen(m_player.getX(), m_player.getY());
+    int playerDistance = std::max(0, m_maze.getStartDistance(playerCell.first, playerCell.second));
+    int nearMax = playerDistance - POWERUP_MIN_DISTANCE;
+    int farMin = playerDistance + POWERUP_MIN_DISTANCE;
+    int nearCount = m_maze.countByDistance(0, nearMax);
+    int farCount = m_maze.countByDistance(farMin, m_maze.getMaxStartDistance());
+    if (nearCount + farCount == 0) {
+        return;
+    }
 
-    int powerupX, powerupY;
-    int attempts = 0;
+    int powerupX = -1;
+    int powerupY = -1;
     bool validSpawn = false;
 
-    while (attempts < 100 && !validSpawn) {
-        powerupX = xDist(rng);
-        powerupY = yDist(rng);
-
-        if (!m_maze.isWall(powerupX, powerupY)) {
-            int distFromPlayer = std::abs(powerupX - m_player.getX()) + std::abs(powerupY - m_player.getY());
-            if (distFromPlayer >= 5) {
-                if (!m_key || powerupX != m_key->getX() || powerupY != m_key->getY()) {
-                    bool occupiedByEnemy = false;
-                    for (const auto& enemy : m_enemies) {
-                        if (enemy.getX() == powerupX && enemy.getY() == powerupY) {
-                            occupiedByEnemy = true;
-                            break;
-                        }
-                    }
-                    if (!occupiedByEnemy) {
-                        validSpawn = true;
-                    }
-                }
+    // Only the key and enemies can collide, so this almost always succeeds first time
+    for (int attempt = 0; attempt < 4 && !validSpawn; ++attempt) {
+        bool pickNear = m_rng.uniformInt(0, nearCount + farCount - 1) < nearCount;
+        auto cell = pickNear ? m_maze.sampleByDistance(0, nearMax, m_rng)
+                             : m_maze.sampleByDistance(farMin, m_maze.getMaxStartDistance(), m_rng);
+        powerupX = cell.first;
+        powerupY = cell.second;
+
+        validSpawn = !m_key || powerupX != m_key->getX() || powerupY != m_key->getY();
+        for (const auto& enemy : m_enemies) {
+            if (enemy.getX() == powerupX && enemy.getY() == powerupY) {
+                validSpawn = false;
+                break;
             }
         }
-        attempts++;
     }
 
     if (validSpawn) {
@@ -424,6 +475,122 @@ void Game::updatePowerUps(float deltaTime) {
         m_powerups.end());
 }
 
+void Game::scrollEndlessWindow() {
+    const int chunkSize = ChunkCache::chunkGridSize();
+    const int playerX = m_player.getX();
+    const int playerY = m_player.getY();
+
+    // Keep at least one chunk of loaded maze between the player and each window edge
+    int shiftX = 0;
+    int shiftY = 0;
+    while (playerX - shiftX < chunkSize) shiftX -= chunkSize;
+    while (playerX - shiftX >= m_maze.getGridWidth() - chunkSize) shiftX += chunkSize;
+    while (playerY - shiftY < chunkSize) shiftY -= chunkSize;
+    while (playerY - shiftY >= m_maze.getGridHeight() - chunkSize) shiftY += chunkSize;
+
+    if (shiftX == 0 && shiftY == 0) {
+        return;
+    }
+
+    m_maze.loadWindow(*m_chunks, m_maze.getOriginX() + shiftX, m_maze.getOriginY() + shiftY);
+    m_pathfinder.resetCoarseField();
+    m_threatMap.reset();
+
+    m_player.setPosition(playerX - shiftX, playerY - shiftY);
+    for (auto& enemy : m_enemies) {
+        enemy.onWindowShifted(-shiftX, -shiftY);
+    }
+    m_powerups.clear();
+
+    prefetchAroundWindow();
+}
+
+void Game::prefetchAroundWindow() {
+    const std::int64_t firstX = ChunkCache::chunkOf(m_maze.getOriginX()) - 1;
+    const std::int64_t firstY = ChunkCache::chunkOf(m_maze.getOriginY()) - 1;
+    const std::int64_t lastX = ChunkCache::chunkOf(m_maze.getOriginX() + m_maze.getGridWidth() - 1) + 1;
+    const std::int64_t lastY = ChunkCache::chunkOf(m_maze.getOriginY() + m_maze.getGridHeight() - 1) + 1;
+
+    for (std::int64_t chunkY = firstY; chunkY <= lastY; ++chunkY) {
+        for (std::int64_t chunkX = firstX; chunkX <= lastX; ++chunkX) {
+            if (chunkX == firstX || chunkX == lastX || chunkY == firstY || chunkY == lastY) {
+                m_chunks->prefetch(chunkX, chunkY);
+            }
+        }
+    }
+}
+
+sf::Vector2u Game::windowSizeForMaze(int mazeWidth, int mazeHeight) {
+    float worldWidth = static_cast<float>((mazeWidth * 2 + 1) * CELL_SIZE);
+    float worldHeight = static_cast<float>((mazeHeight * 2 + 1) * CELL_SIZE);
+
+    // Scale down (never up) so the longer side fits MAX_WINDOW_SIZE
+    float scale = std::min(1.0f, MAX_WINDOW_SIZE / std::max(worldWidth, worldHeight));
+    return sf::Vector2u(static_cast<unsigned>(worldWidth * scale), static_cast<unsigned>(worldHeight * scale));
+}
+
+void Game::updateView() {
+    sf::Vector2f worldSize(static_cast<float>(m_maze.getGridWidth() * CELL_SIZE),
+                           static_cast<float>(m_maze.getGridHeight() * CELL_SIZE));
+    sf::Vector2f windowSize(static_cast<float>(m_window.getSize().x), static_cast<float>(m_window.getSize().y));
+
+    // Letterbox the maze so cells stay square
+    m_worldView = sf::View(sf::FloatRect(sf::Vector2f(0.0f, 0.0f), worldSize));
+    float windowRatio = windowSize.x / windowSize.y;
+    float worldRatio = worldSize.x / worldSize.y;
+    sf::FloatRect viewport(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(1.0f, 1.0f));
+    if (windowRatio > worldRatio) {
+        viewport.size.x = worldRatio / windowRatio;
+        viewport.position.x = (1.0f - viewport.size.x) / 2.0f;
+    } else if (windowRatio < worldRatio) {
+        viewport.size.y = windowRatio / worldRatio;
+        viewport.position.y = (1.0f - viewport.size.y) / 2.0f;
+    }
+    m_worldView.setViewport(viewport);
+
+    m_screenView = sf::View(sf::FloatRect(sf::Vector2f(0.0f, 0.0f), windowSize));
+
+    if (m_roundBackgroundSprite) {
+        m_roundBackgroundSprite->setScale(sf::Vector2f(windowSize.x / m_roundBackgroundTexture.getSize().x,
+                                                       windowSize.y / m_roundBackgroundTexture.getSize().y));
+    }
+    if (m_gameOverSprite) {
+        m_gameOverSprite->setScale(sf::Vector2f(windowSize.x / m_gameOverTexture.getSize().x,
+                                                windowSize.y / m_gameOverTexture.getSize().y));
+    }
+    m_roundText.setPosition(sf::Vector2f(windowSize.x / 2.0f, windowSize.y / 2.0f));
+}
+
+void Game::logAiStats() const {
+    int nearCount = 0;
+    int farCount = 0;
+    int lodSwitches = 0;
+    int pathSearches = 0;
+    int coarseSteps = 0;
+
+    for (const auto& enemy : m_enemies) {
+        if (enemy.getLod() == AiLod::EXACT) {
+            nearCount++;
+        } else {
+            farCount++;
+        }
+        lodSwitches += enemy.getLodSwitchCount();
+        pathSearches += enemy.getPathSearchCount();
+        coarseSteps += enemy.getCoarseStepCount();
+    }
+
+    std::cout << "AI stats: " << nearCount << " near / " << farCount << " far enemies, "
+              << lodSwitches << " LOD switches, " << pathSearches << " exact searches, "
+              << coarseSteps << " coarse steps, " << m_pathfinder.getCoarseFieldBuildCount()
+              << " coarse field builds" << std::endl;
+    std::cout << "Line-of-sight spans: " << m_maze.getVisibilityMemoryBytes() << " bytes" << std::endl;
+
+    if (m_chunks) {
+        std::cout << "Endless world: " << m_chunks->getGeneratedCount() << " chunks generated, "
+                  << m_chunks->getCachedCount() << " cached" << std::endl;
+    }
+}
+
 bool Game::loadTextures() {
     bool player1Loaded = m_playerTexture1.loadFromFile("src/assets/player1.png");
     bool player2Loaded = m_playerTexture2.loadFromFile("src/assets/player2.png");
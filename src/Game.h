@@ -1,7 +1,12 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
 
+#include "ChunkCache.h"
 #include "Config.h"
 #include "Enemy.h"
 #include "Key.h"
@@ -9,6 +14,7 @@
 #include "Pathfinder.h"
 #include "Player.h"
 #include "PowerUp.h"
+#include "ThreatMap.h"
 
 /**
  * @brief Main game class that manages the game loop, window, and player
@@ -22,10 +28,20 @@ class Game {
     /**
      * @brief Constructs a new Game object
      *
+     * @param mazeWidth Maze width in logical cells
+     * @param mazeHeight Maze height in logical cells
+     * @param endless Play in an endless chunked world instead of escape rounds
+     * @param algorithm Algorithm that carves every round's maze
+     * @param arena Hand-made maze played every round instead (copied; null = generate)
+     *
      * Initializes the SFML window, sets up the player rectangle,
-     * and configures initial game parameters.
+     * and configures initial game parameters. The window is sized to fit
+     * the maze, scaled down when it would exceed MAX_WINDOW_SIZE. In endless
+     * mode the maze is a window of ENDLESS_WINDOW_CHUNKS chunks that scrolls
+     * with the player.
      */
-    Game();
+    Game(int mazeWidth = DEFAULT_MAZE_WIDTH, int mazeHeight = DEFAULT_MAZE_HEIGHT, bool endless = false,
+         MazeAlgorithm algorithm = MazeAlgorithm::DFS, const Maze* arena = nullptr);
 
     /**
      * @brief Runs the main game loop
@@ -86,12 +102,18 @@ class Game {
      */
     void checkKeyCollection();
 
+    /**
+     * @brief Tells the enemies where the player is heading (the key, then the exits)
+     */
+    void updateEnemyGoals();
+
     /**
      * @brief Spawns enemies for the current round
-     * 
+     *
      * @param roundNumber Current round number (1-5)
+     * @param spawnPositions One cell per enemy type ((-1, -1) skips that enemy)
      */
-    void spawnEnemiesForRound(int roundNumber);
+    void spawnEnemiesForRound(int roundNumber, const std::vector<std::pair<int, int>>& spawnPositions);
     
     /**
      * @brief Starts the round transition screen
@@ -105,10 +127,37 @@ class Game {
      */
     void updateRoundTransition(float deltaTime);
     
+    /**
+     * @brief Everything a round needs that can be computed before play starts
+     */
+    struct RoundPlan {
+        std::pair<int, int> start;                            ///< Player start cell
+        std::pair<int, int> keyPosition;                      ///< Key cell ((-1, -1) in endless mode)
+        std::vector<std::pair<int, int>> enemySpawns;         ///< One cell per enemy type
+        Pathfinder pathfinder;                                ///< Coarse route to the start, built for the prepared maze
+    };
+
+    /**
+     * @brief Builds the next round's maze and derived data into m_nextMaze
+     *
+     * @return Start, key and spawn positions for the prepared maze
+     *
+     * Runs on a worker thread during the round transition. Positions are
+     * O(1) samples from the maze's distance-from-start analysis. The coarse
+     * route is built into the plan's own pathfinder. The worker touches only
+     * m_nextMaze and the plan; the enemies' pathfinder is left alone.
+     */
+    RoundPlan prepareRound();
+
     /**
      * @brief Sets up the actual round (maze, key, enemies)
+     *
+     * @param plan Result of prepareRound
+     *
+     * Swaps the prepared maze and its coarse route in, so no generation runs
+     * on the main thread.
      */
-    void setupRound();
+    void setupRound(RoundPlan plan);
 
     /**
      * @brief Restarts the game from round 1
@@ -132,6 +181,40 @@ class Game {
      */
     void updatePowerUps(float deltaTime);
 
+    /**
+     * @brief Computes a window size that fits the maze
+     *
+     * @param mazeWidth Maze width in logical cells
+     * @param mazeHeight Maze height in logical cells
+     * @return Window size in pixels, at most MAX_WINDOW_SIZE on the longer side
+     */
+    static sf::Vector2u windowSizeForMaze(int mazeWidth, int mazeHeight);
+
+    /**
+     * @brief Fits the world view to the maze and the screen view to the window
+     *
+     * Letterboxes the maze so cells stay square. Called on startup and resize.
+     */
+    void updateView();
+
+    /**
+     * @brief Scrolls the endless-mode window by whole chunks to keep the player central
+     *
+     * Reloads the maze from the chunk cache and moves the player and enemies
+     * into the new window coordinates. Power-ups left behind are dropped.
+     */
+    void scrollEndlessWindow();
+
+    /**
+     * @brief Queues the ring of chunks around the endless-mode window for background generation
+     */
+    void prefetchAroundWindow();
+
+    /**
+     * @brief Prints enemy AI statistics (LOD bands, switches, search counts, line-of-sight memory)
+     */
+    void logAiStats() const;
+
     /**
      * @brief Loads enemy textures
      *
@@ -140,20 +223,28 @@ class Game {
     bool loadTextures();
 
     sf::RenderWindow m_window;
+    sf::View m_worldView;   ///< Maze coordinates, letterboxed into the window
+    sf::View m_screenView;  ///< Window pixel coordinates for full-screen overlays
     Player m_player;
     Maze m_maze;
+    Maze m_nextMaze;                       ///< Next round's maze, built by prepareRound during the transition
+    std::unique_ptr<ChunkCache> m_chunks;  ///< Endless-mode world (null in escape rounds)
+    std::unique_ptr<Maze> m_arena;         ///< Imported maze reused every round (null = generate each round)
 
     // Enemy AI
     Pathfinder m_pathfinder;
     std::vector<Enemy> m_enemies;
+    ThreatMap m_threatMap;
     Key* m_key;
     bool m_hasKey;
     int m_currentRound;
     bool m_gameOver;
+    bool m_showThreatOverlay;  ///< Toggled with T
     
     // Power-ups
     std::vector<PowerUp> m_powerups;
     sf::Clock m_powerupSpawnTimer;
+    Random m_rng;  ///< Power-up placement
     
     // Textures
     sf::Texture m_playerTexture1, m_playerTexture2;
@@ -172,4 +263,7 @@ class Game {
     sf::Text m_roundText;
     std::unique_ptr<sf::Sprite> m_roundBackgroundSprite;
     std::unique_ptr<sf::Sprite> m_gameOverSprite;
+
+    // Declared last so it is destroyed first: waits for a pending prepareRound
+    std::future<RoundPlan> m_nextRound;
 };
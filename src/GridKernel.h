@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+
+/**
+ * @brief Row-major maze grid whose size is fixed at compile time
+ *
+ * @tparam Width Grid width in cells
+ * @tparam Height Grid height in cells
+ *
+ * Cells live in a std::array with a one-cell wall border, so the stride,
+ * the neighbor offsets and every index computation are compile-time
+ * constants the kernels below can fold and unroll.
+ */
+template <int Width, int Height>
+class FixedGrid {
+   public:
+    static constexpr int STRIDE = Width + 2;            ///< Row stride including the border
+    static constexpr int SIZE = STRIDE * (Height + 2);  ///< Cell count including the border
+
+    static constexpr int width() { return Width; }
+    static constexpr int height() { return Height; }
+    static constexpr int stride() { return STRIDE; }
+    static constexpr int size() { return SIZE; }
+
+    /**
+     * @brief Gets the storage index of a cell (-1 to width/height inclusive)
+     */
+    static constexpr int index(int x, int y) { return (y + 1) * STRIDE + x + 1; }
+    static constexpr int xOf(int index) { return index % STRIDE - 1; }
+    static constexpr int yOf(int index) { return index / STRIDE - 1; }
+
+    /**
+     * @brief Checks if a maze (or any grid with getGridWidth/getGridHeight) has this size
+     */
+    template <class Source>
+    static bool fits(const Source& source) {
+        return source.getGridWidth() == Width && source.getGridHeight() == Height;
+    }
+
+    /**
+     * @brief Copies the cells of a maze of exactly this size
+     *
+     * @param source Maze (anything with isWallUnchecked) for which fits() is true
+     */
+    template <class Source>
+    void load(const Source& source) {
+        m_cells.fill(CELL_WALL);
+        for (int y = 0; y < Height; ++y) {
+            for (int x = 0; x < Width; ++x) {
+                m_cells[index(x, y)] = source.isWallUnchecked(x, y) ? CELL_WALL : CELL_EMPTY;
+            }
+        }
+    }
+
+    bool isWall(int index) const { return m_cells[index] == CELL_WALL; }
+
+   private:
+    std::array<std::uint8_t, SIZE> m_cells{};
+};
+
+/**
+ * @brief Runtime-sized fallback with the same interface as FixedGrid
+ */
+class DynamicGrid {
+   public:
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int stride() const { return m_width + 2; }
+    int size() const { return static_cast<int>(m_cells.size()); }
+    int index(int x, int y) const { return (y + 1) * stride() + x + 1; }
+    int xOf(int index) const { return index % stride() - 1; }
+    int yOf(int index) const { return index / stride() - 1; }
+
+    template <class Source>
+    void load(const Source& source) {
+        m_width = source.getGridWidth();
+        m_height = source.getGridHeight();
+        m_cells.assign(stride() * (m_height + 2), CELL_WALL);
+        for (int y = 0; y < m_height; ++y) {
+            for (int x = 0; x < m_width; ++x) {
+                m_cells[index(x, y)] = source.isWallUnchecked(x, y) ? CELL_WALL : CELL_EMPTY;
+            }
+        }
+    }
+
+    bool isWall(int index) const { return m_cells[index] == CELL_WALL; }
+
+   private:
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<std::uint8_t> m_cells;
+};
+
+/**
+ * @brief Fixed-size grid for the stock game size
+ */
+using DefaultGrid = FixedGrid<DEFAULT_MAZE_WIDTH * 2 + 1, DEFAULT_MAZE_HEIGHT * 2 + 1>;
+
+/**
+ * @brief Fills a BFS distance field from one target over a grid
+ *
+ * @param grid FixedGrid or DynamicGrid
+ * @param target Storage index of the target (must be open)
+ * @param field Receives steps per storage index (-1 = unreachable or wall)
+ * @param queue Scratch buffer, reused between calls
+ *
+ * The border is wall, so neighbors need no bounds checks; the four
+ * neighbor visits are written out rather than looped.
+ */
+template <class Grid>
+void fillDistanceField(const Grid& grid, int target, std::vector<int>& field, std::vector<int>& queue) {
+    const int stride = grid.stride();
+    field.assign(grid.size(), -1);
+    queue.clear();
+    queue.reserve(grid.size());
+
+    field[target] = 0;
+    queue.push_back(target);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int index = queue[head];
+        int next = field[index] + 1;
+
+        auto visit = [&](int neighbor) {
+            if (field[neighbor] < 0 && !grid.isWall(neighbor)) {
+                field[neighbor] = next;
+                queue.push_back(neighbor);
+            }
+        };
+        visit(index - stride);
+        visit(index + stride);
+        visit(index - 1);
+        visit(index + 1);
+    }
+}
+
+/**
+ * @brief Finds a shortest path between two open cells with a BFS
+ *
+ * @param grid FixedGrid or DynamicGrid
+ * @param startX Start X coordinate
+ * @param startY Start Y coordinate
+ * @param goalX Goal X coordinate
+ * @param goalY Goal Y coordinate
+ * @param parent Scratch buffer, reused between calls
+ * @param queue Scratch buffer, reused between calls
+ * @return Path from start to goal inclusive, or empty if there is none
+ *
+ * The start may be a wall cell (e.g. walled in by an edit); the search
+ * simply leaves it through any open neighbor.
+ */
+template <class Grid>
+std::vector<std::pair<int, int>> findShortestPath(const Grid& grid, int startX, int startY, int goalX, int goalY,
+                                                  std::vector<int>& parent, std::vector<int>& queue) {
+    const int stride = grid.stride();
+    const int start = grid.index(startX, startY);
+    const int goal = grid.index(goalX, goalY);
+    if (grid.isWall(goal)) {
+        return {};
+    }
+
+    parent.assign(grid.size(), -1);
+    queue.clear();
+    parent[start] = start;
+    queue.push_back(start);
+
+    bool found = start == goal;
+    for (size_t head = 0; head < queue.size() && !found; ++head) {
+        int index = queue[head];
+
+        auto visit = [&](int neighbor) {
+            if (parent[neighbor] < 0 && !grid.isWall(neighbor)) {
+                parent[neighbor] = index;
+                queue.push_back(neighbor);
+                found |= neighbor == goal;
+            }
+        };
+        visit(index - stride);
+        visit(index + stride);
+        visit(index - 1);
+        visit(index + 1);
+    }
+
+    if (!found) {
+        return {};
+    }
+
+    std::vector<std::pair<int, int>> path;
+    for (int index = goal; index != start; index = parent[index]) {
+        path.push_back({grid.xOf(index), grid.yOf(index)});
+    }
+    path.push_back({startX, startY});
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+/**
+ * @brief Queue order of findBestFirstPath
+ */
+enum class SearchOrder {
+    A_STAR,    // Steps from the start plus Manhattan distance to the goal
+    DIJKSTRA,  // Steps from the start
+    GREEDY     // Manhattan distance to the goal only; finds a path, not the shortest
+};
+
+/**
+ * @brief Scratch buffers for findBestFirstPath, reused between calls
+ *
+ * Per-cell entries count only where their stamp matches the current search,
+ * so nothing is cleared between searches.
+ */
+struct BestFirstScratch {
+    /**
+     * @brief Queue entry: a cell and the priority it was pushed with
+     */
+    struct Entry {
+        int priority;  ///< Queue key (see SearchOrder)
+        int index;     ///< Storage index of the cell
+    };
+
+    std::vector<int> cost;              ///< Per storage index: steps from the start
+    std::vector<int> parent;            ///< Per storage index: previous cell on the best route
+    std::vector<std::uint32_t> queued;  ///< Per storage index: stamp of the search that queued it
+    std::vector<std::uint32_t> closed;  ///< Per storage index: stamp of the search that expanded it
+    std::vector<Entry> heap;            ///< Binary min-heap on priority
+    std::uint32_t stamp = 0;            ///< Current search
+};
+
+/**
+ * @brief Finds a path between two cells with A*, Dijkstra or greedy best-first search
+ *
+ * @tparam Order Queue order
+ * @param grid FixedGrid or DynamicGrid
+ * @param startX Start X coordinate
+ * @param startY Start Y coordinate
+ * @param goalX Goal X coordinate
+ * @param goalY Goal Y coordinate
+ * @param scratch Scratch buffers, reused between calls
+ * @return Path from start to goal inclusive, or empty if there is none
+ *
+ * The heap compares priorities only, and neighbors are queued up, down,
+ * left, right, so equal-priority ties break the same way as the original
+ * node-based search. A cheaper route to a queued cell pushes it again; the
+ * older entry is skipped when it surfaces. Greedy never revisits a queued
+ * cell. The start may be a wall cell (e.g. walled in by an edit).
+ */
+template <SearchOrder Order, class Grid>
+std::vector<std::pair<int, int>> findBestFirstPath(const Grid& grid, int startX, int startY, int goalX, int goalY,
+                                                   BestFirstScratch& scratch) {
+    const int stride = grid.stride();
+    const int start = grid.index(startX, startY);
+    const int goal = grid.index(goalX, goalY);
+    if (start == goal) {
+        return {{startX, startY}};
+    }
+    if (grid.isWall(goal)) {
+        return {};
+    }
+
+    if (scratch.queued.size() != static_cast<size_t>(grid.size()) || ++scratch.stamp == 0) {
+        scratch.cost.assign(grid.size(), 0);
+        scratch.parent.assign(grid.size(), -1);
+        scratch.queued.assign(grid.size(), 0);
+        scratch.closed.assign(grid.size(), 0);
+        scratch.stamp = 1;
+    }
+    const std::uint32_t stamp = scratch.stamp;
+    auto later = [](const BestFirstScratch::Entry& a, const BestFirstScratch::Entry& b) {
+        return a.priority > b.priority;
+    };
+    auto priority = [&](int cost, int x, int y) {
+        int distance = std::abs(x - goalX) + std::abs(y - goalY);
+        if (Order == SearchOrder::A_STAR) return cost + distance;
+        if (Order == SearchOrder::DIJKSTRA) return cost;
+        return distance;
+    };
+
+    auto& heap = scratch.heap;
+    heap.clear();
+    scratch.cost[start] = 0;
+    scratch.queued[start] = stamp;
+    heap.push_back({priority(0, startX, startY), start});
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        const int index = heap.back().index;
+        heap.pop_back();
+        if (scratch.closed[index] == stamp) {
+            continue;  // Superseded by a cheaper entry for the same cell
+        }
+        scratch.closed[index] = stamp;
+
+        if (index == goal) {
+            std::vector<std::pair<int, int>> path;
+            for (int cell = goal; cell != start; cell = scratch.parent[cell]) {
+                path.push_back({grid.xOf(cell), grid.yOf(cell)});
+            }
+            path.push_back({startX, startY});
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        const int x = grid.xOf(index);
+        const int y = grid.yOf(index);
+        const int next = scratch.cost[index] + 1;
+
+        auto visit = [&](int neighbor, int neighborX, int neighborY) {
+            if (grid.isWall(neighbor) || scratch.closed[neighbor] == stamp) {
+                return;
+            }
+            if (scratch.queued[neighbor] == stamp) {
+                if (Order == SearchOrder::GREEDY || next >= scratch.cost[neighbor]) {
+                    return;
+                }
+            }
+            scratch.queued[neighbor] = stamp;
+            scratch.cost[neighbor] = next;
+            scratch.parent[neighbor] = index;
+            heap.push_back({priority(next, neighborX, neighborY), neighbor});
+            std::push_heap(heap.begin(), heap.end(), later);
+        };
+        visit(index - stride, x, y - 1);
+        visit(index + stride, x, y + 1);
+        visit(index - 1, x - 1, y);
+        visit(index + 1, x + 1, y);
+    }
+
+    return {};
+}
+
+// Wall-line mask bits (buildWallMasks)
+const std::uint8_t WALL_MASK_ABOVE = 1;
+const std::uint8_t WALL_MASK_RIGHT = 2;
+const std::uint8_t WALL_MASK_BELOW = 4;
+const std::uint8_t WALL_MASK_LEFT = 8;
+const std::uint8_t WALL_MASK_SELF = 16;
+
+/**
+ * @brief Computes the wall-line mask the renderer draws for every cell
+ *
+ * @param grid FixedGrid or DynamicGrid
+ * @param masks Receives one mask per cell (y * width + x): 0 for open cells,
+ *              otherwise WALL_MASK_SELF plus one bit per wall neighbor
+ *
+ * Neighbors outside the grid don't count, matching Maze::drawWallLines.
+ */
+template <class Grid>
+void buildWallMasks(const Grid& grid, std::vector<std::uint8_t>& masks) {
+    const int width = grid.width();
+    const int height = grid.height();
+    const int stride = grid.stride();
+    masks.assign(width * height, 0);
+
+    for (int y = 0; y < height; ++y) {
+        // Edge rows and columns mask out the sentinel border
+        std::uint8_t rowMask = WALL_MASK_LEFT | WALL_MASK_RIGHT | (y > 0 ? WALL_MASK_ABOVE : 0) |
+                               (y < height - 1 ? WALL_MASK_BELOW : 0);
+        int index = grid.index(0, y);
+        for (int x = 0; x < width; ++x, ++index) {
+            if (!grid.isWall(index)) {
+                continue;
+            }
+            std::uint8_t mask = WALL_MASK_SELF | (grid.isWall(index - stride) ? WALL_MASK_ABOVE : 0) |
+                                (grid.isWall(index + 1) ? WALL_MASK_RIGHT : 0) |
+                                (grid.isWall(index + stride) ? WALL_MASK_BELOW : 0) |
+                                (grid.isWall(index - 1) ? WALL_MASK_LEFT : 0);
+            std::uint8_t edgeMask = rowMask;
+            if (x == 0) edgeMask &= ~WALL_MASK_LEFT;
+            if (x == width - 1) edgeMask &= ~WALL_MASK_RIGHT;
+            masks[y * width + x] = mask & (edgeMask | WALL_MASK_SELF);
+        }
+    }
+}
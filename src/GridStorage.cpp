@@ -0,0 +1,76 @@
+#include "GridStorage.h"
+
+#include <cstring>
+
+GridStorage::GridStorage(int width, int height, GridLayout layout)
+    : m_width(width), m_height(height), m_stride(width + 2), m_layout(layout) {
+    size_t paddedWidth = width + 2;
+    size_t paddedHeight = height + 2;
+
+    // Blocked indices OR disjoint bit fields, so each splits into a row part plus a column part
+    switch (m_layout) {
+        case GridLayout::TILED: {
+            size_t blocksX = (paddedWidth + 7) / 8;
+            size_t blocksY = (paddedHeight + 7) / 8;
+            m_rowBase.resize(paddedHeight);
+            m_columnOffset.resize(paddedWidth);
+            for (size_t py = 0; py < paddedHeight; ++py) {
+                m_rowBase[py] = ((py >> 3) * blocksX << 6) | ((py & 7) << 3);
+            }
+            for (size_t px = 0; px < paddedWidth; ++px) {
+                m_columnOffset[px] = ((px >> 3) << 6) | (px & 7);
+            }
+            m_cells.assign(blocksX * blocksY * 64, CELL_WALL);
+            break;
+        }
+        case GridLayout::MORTON: {
+            size_t blocksX = (paddedWidth + 63) / 64;
+            size_t blocksY = (paddedHeight + 63) / 64;
+            m_rowBase.resize(paddedHeight);
+            m_columnOffset.resize(paddedWidth);
+            for (size_t py = 0; py < paddedHeight; ++py) {
+                m_rowBase[py] = ((py >> 6) * blocksX << 12) | (spreadBits(py & 63) << 1);
+            }
+            for (size_t px = 0; px < paddedWidth; ++px) {
+                m_columnOffset[px] = ((px >> 6) << 12) | spreadBits(px & 63);
+            }
+            m_cells.assign(blocksX * blocksY * 4096, CELL_WALL);
+            break;
+        }
+        case GridLayout::ROW_MAJOR:
+        default:
+            m_layout = GridLayout::ROW_MAJOR;
+            m_cells.assign(paddedWidth * paddedHeight, CELL_WALL);
+            break;
+    }
+}
+
+void GridStorage::fill(std::uint8_t value) {
+    std::vector<std::uint8_t> row(m_width, value);
+    for (int y = 0; y < m_height; ++y) {
+        writeRow(0, y, row.data(), m_width);
+    }
+}
+
+const std::uint8_t* GridStorage::readRow(int y, std::vector<std::uint8_t>& buffer) const {
+    if (m_layout == GridLayout::ROW_MAJOR) {
+        return row(y);
+    }
+    buffer.resize(m_stride);
+    const size_t base = m_rowBase[y + 1];
+    for (int px = 0; px < m_stride; ++px) {
+        buffer[px] = m_cells[base + m_columnOffset[px]];
+    }
+    return buffer.data() + 1;
+}
+
+void GridStorage::writeRow(int x, int y, const std::uint8_t* values, int count) {
+    if (m_layout == GridLayout::ROW_MAJOR) {
+        std::memcpy(&m_cells[index(x, y)], values, count);
+        return;
+    }
+    const size_t base = m_rowBase[y + 1];
+    for (int i = 0; i < count; ++i) {
+        m_cells[base + m_columnOffset[x + i + 1]] = values[i];
+    }
+}
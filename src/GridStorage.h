@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Config.h"
+
+/**
+ * @brief Padded cell storage for the maze grid with a selectable memory layout
+ *
+ * Every cell one step outside the grid belongs to a sentinel wall border, so
+ * neighbors of in-grid cells can be read without bounds checks in any layout.
+ *
+ * - ROW_MAJOR: rows stored one after another
+ * - TILED: 8x8 tiles of 64 bytes (one cache line each), tiles row-major
+ * - MORTON: Z-order inside 64x64 blocks (4 KB pages), blocks row-major
+ *
+ * The blocked layouts keep vertical neighbors within the same cache line or
+ * page, which matters for BFS/A* on grids with millions of cells.
+ */
+class GridStorage {
+   public:
+    /**
+     * @brief Constructs a grid filled with walls
+     *
+     * @param width Grid width in cells (excluding the border)
+     * @param height Grid height in cells (excluding the border)
+     * @param layout Memory layout for the cells
+     */
+    GridStorage(int width, int height, GridLayout layout = GridLayout::ROW_MAJOR);
+
+    /**
+     * @brief Gets the storage index of a cell
+     *
+     * @param x X coordinate, -1 to width inclusive
+     * @param y Y coordinate, -1 to height inclusive
+     * @return Index into the cell buffer
+     *
+     * Row-major is computed directly. A blocked index is a row part plus a
+     * column part, so those layouts read two offset tables built at
+     * construction instead of decoding tiles on every access.
+     */
+    size_t index(int x, int y) const {
+        if (m_layout == GridLayout::ROW_MAJOR) {
+            return static_cast<size_t>(y + 1) * m_stride + (x + 1);
+        }
+        return m_rowBase[y + 1] + m_columnOffset[x + 1];
+    }
+
+    /**
+     * @brief Reads a cell
+     *
+     * @param x X coordinate, -1 to width inclusive
+     * @param y Y coordinate, -1 to height inclusive
+     * @return Cell value
+     */
+    std::uint8_t get(int x, int y) const { return m_cells[index(x, y)]; }
+
+    /**
+     * @brief Mutable access to a cell
+     *
+     * @param x X coordinate, -1 to width inclusive
+     * @param y Y coordinate, -1 to height inclusive
+     * @return Reference to the cell value
+     */
+    std::uint8_t& at(int x, int y) { return m_cells[index(x, y)]; }
+
+    /**
+     * @brief Sets every in-grid cell to a value; the border stays wall
+     *
+     * @param value Cell value to write
+     */
+    void fill(std::uint8_t value);
+
+    /**
+     * @brief Gets a row in place for bulk scans
+     *
+     * @param y Row, -1 to height inclusive
+     * @return Pointer to cell (0, y); indices -1 to width are readable
+     *
+     * Only valid for GridLayout::ROW_MAJOR; readRow works for every layout.
+     */
+    const std::uint8_t* row(int y) const {
+        assert(m_layout == GridLayout::ROW_MAJOR);
+        return &m_cells[static_cast<size_t>(y + 1) * m_stride + 1];
+    }
+
+    /**
+     * @brief Gets a row as contiguous cells for bulk scans
+     *
+     * @param y Row, -1 to height inclusive
+     * @param buffer Scratch space for layouts that don't store rows contiguously
+     * @return Pointer to cell (0, y); indices -1 to width are readable
+     *
+     * Row-major rows are returned in place. The blocked layouts gather the row
+     * into buffer, so the pointer is valid until buffer changes.
+     */
+    const std::uint8_t* readRow(int y, std::vector<std::uint8_t>& buffer) const;
+
+    /**
+     * @brief Copies a run of cells into a row
+     *
+     * @param x First column, 0 to width - count
+     * @param y Row, 0 to height - 1
+     * @param values Cells to copy
+     * @param count Number of cells
+     */
+    void writeRow(int x, int y, const std::uint8_t* values, int count);
+
+    /**
+     * @brief Gets the grid width
+     *
+     * @return Width in cells (excluding the border)
+     */
+    int getWidth() const { return m_width; }
+
+    /**
+     * @brief Gets the grid height
+     *
+     * @return Height in cells (excluding the border)
+     */
+    int getHeight() const { return m_height; }
+
+    /**
+     * @brief Gets the memory layout
+     *
+     * @return Layout chosen at construction
+     */
+    GridLayout getLayout() const { return m_layout; }
+
+    /**
+     * @brief Gets the size of the cell buffer
+     *
+     * @return Number of storage slots (includes border and tile padding)
+     */
+    size_t size() const { return m_cells.size(); }
+
+   private:
+    /**
+     * @brief Spreads the low 6 bits of v to the even bit positions
+     */
+    static size_t spreadBits(unsigned v) {
+        v = (v | (v << 4)) & 0x0F0F;
+        v = (v | (v << 2)) & 0x3333;
+        v = (v | (v << 1)) & 0x5555;
+        return v;
+    }
+
+    int m_width;                        ///< Grid width in cells
+    int m_height;                       ///< Grid height in cells
+    int m_stride;                       ///< Padded width (row-major stride)
+    GridLayout m_layout;                ///< Memory layout
+    std::vector<size_t> m_rowBase;      ///< Blocked layouts, per padded row: index of padded column 0
+    std::vector<size_t> m_columnOffset; ///< Blocked layouts, per padded column: offset from the row base
+    std::vector<std::uint8_t> m_cells;  ///< Cell buffer: 0=path, 1=wall
+};
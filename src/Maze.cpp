@@ -1,23 +1,187 @@
 #include "Maze.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
 
-Maze::Maze()
-    : m_grid(GRID_HEIGHT, std::vector<int>(GRID_WIDTH, CELL_WALL)), m_rng(std::random_device{}()) {
-    generateDFS();
+#include "BitGrid.h"
+#include "ChunkCache.h"
+#include "GridKernel.h"
+#include "MazeFile.h"
+#include "MazeImage.h"
+#include "UnionFind.h"
+
+namespace {
+
+// Shared by every maze, so a version never matches a table built for another maze
+std::atomic<std::uint64_t> nextVersion{1};
+
+/**
+ * @brief Draws 64 random bits, each set with about the given chance
+ *
+ * Builds the chance as an 8-bit binary fraction: each fraction bit ANDs or
+ * ORs in a fresh random word, so 64 cells cost 16 generator calls.
+ */
+std::uint64_t randomBits(Random& rng, int percent) {
+    const int threshold = (percent * 256 + 50) / 100;
+    if (threshold >= 256) {
+        return ~std::uint64_t(0);
+    }
+    std::uint64_t bits = 0;
+    for (int bit = 0; bit < 8; ++bit) {
+        std::uint64_t high = rng();
+        std::uint64_t word = (high << 32) | rng();
+        bits = ((threshold >> bit) & 1) ? bits | word : bits & word;
+    }
+    return bits;
+}
+
+}  // namespace
+
+Maze::Maze(int mazeWidth, int mazeHeight, GridLayout layout) : Maze(mazeWidth, mazeHeight, layout, randomSeed()) {}
+
+Maze::Maze(int mazeWidth, int mazeHeight, GridLayout layout, std::uint64_t seed, MazeAlgorithm algorithm)
+    : m_layout(std::make_shared<Layout>(mazeWidth * 2 + 1, mazeHeight * 2 + 1, layout)), m_rng(seed) {
+    m_layout->seed = seed;
+    m_layout->algorithm = algorithm;
+    generate();
+    rebuildDerivedData();
+}
+
+Maze::Maze(const MazeFile& file, GridLayout layout)
+    : m_layout(std::make_shared<Layout>(file.getGridWidth(), file.getGridHeight(), layout)), m_rng(file.getSeed()) {
+    m_layout->seed = file.getSeed();
+    for (int y = 0; y < getGridHeight(); ++y) {
+        for (int x = 0; x < getGridWidth(); ++x) {
+            at(x, y) = file.isWall(x, y) ? CELL_WALL : CELL_EMPTY;
+        }
+    }
+    rebuildDerivedData();
+}
+
+Maze::Maze(const MazeImage& image, GridLayout layout)
+    : m_layout(std::make_shared<Layout>(image.getGridWidth(), image.getGridHeight(), layout)),
+      m_rng(image.getChecksum()) {
+    m_layout->seed = image.getChecksum();
+    for (int y = 0; y < getGridHeight(); ++y) {
+        for (int x = 0; x < getGridWidth(); ++x) {
+            at(x, y) = image.isWall(x, y) ? CELL_WALL : CELL_EMPTY;
+        }
+    }
+    rebuildDerivedData();
+}
+
+Maze::Maze(std::shared_ptr<Layout> layout) : m_layout(std::move(layout)) {}
+
+Maze Maze::placeholder(int mazeWidth, int mazeHeight, MazeAlgorithm algorithm) {
+    auto layout = std::make_shared<Layout>(mazeWidth * 2 + 1, mazeHeight * 2 + 1, GridLayout::ROW_MAJOR);
+    layout->cells.fill(CELL_WALL);
+    layout->algorithm = algorithm;
+    layout->version = nextVersion.fetch_add(1);
+    return Maze(std::move(layout));
+}
+
+Maze::Maze(const Maze& other) : m_rng(other.m_rng) {
+    // A shared layout must never be rebuilt lazily, so settle the analysis first
+    other.ensureAnalysis();
+    m_layout = other.m_layout;
+}
+
+Maze& Maze::operator=(const Maze& other) {
+    if (this != &other) {
+        other.ensureAnalysis();
+        m_layout = other.m_layout;
+        m_rng = other.m_rng;
+        m_wallMasks.clear();
+        m_wallMaskVersion = 0;
+    }
+    return *this;
+}
+
+void Maze::detach(bool keepContents) {
+    if (m_layout.use_count() == 1) {
+        return;
+    }
+    if (keepContents) {
+        // A whole-Layout copy would duplicate megabytes of tables for a few changed cells
+        const Layout& shared = *m_layout;
+        auto copy = std::make_shared<Layout>(shared.cells);
+        copy->seed = shared.seed;
+        copy->algorithm = shared.algorithm;
+        copy->endless = shared.endless;
+        copy->originX = shared.originX;
+        copy->originY = shared.originY;
+        copy->rowSpan = shared.rowSpan;
+        copy->colSpan = shared.colSpan;
+        copy->nearestOpen = shared.nearestOpen;
+        copy->openDistance = shared.openDistance;
+        copy->maxOpenDistance = shared.maxOpenDistance;
+        copy->version = shared.version;
+        copy->logBase = shared.logBase;
+        copy->editLog = shared.editLog;
+        copy->analysisStale = true;
+        m_layout = std::move(copy);
+    } else {
+        m_layout = std::make_shared<Layout>(getGridWidth(), getGridHeight(), getLayout());
+    }
+}
+
+long Maze::getShareCount() const {
+    return m_layout.use_count();
+}
+
+size_t Maze::getLayoutMemoryBytes() const {
+    const Layout& layout = *m_layout;
+    size_t bytes = sizeof(Layout) + layout.cells.size();
+    bytes += layout.rowSpan.getMemoryBytes() + layout.colSpan.getMemoryBytes() + layout.nearestOpen.getMemoryBytes() +
+             layout.openDistance.getMemoryBytes();
+    bytes += (layout.startDistance.capacity() + layout.cellBlock.capacity() + layout.blockHead.capacity() +
+              layout.blockDepth.capacity()) * sizeof(int);
+    bytes += layout.cellKinds.capacity() * sizeof(CellKind) + layout.cutFlags.capacity();
+    bytes += (layout.reachable.cells.capacity() + layout.reachable.firstAtDistance.capacity()) * sizeof(int);
+    for (const auto& index : layout.byKind) {
+        bytes += (index.cells.capacity() + index.firstAtDistance.capacity()) * sizeof(int);
+    }
+    return bytes + layout.editLog.size() * sizeof(EditRecord);
+}
+
+size_t Maze::getHandleMemoryBytes() const {
+    return sizeof(Maze) + m_wallMasks.capacity();
+}
+
+size_t Maze::getOwnedLayoutMemoryBytes() const {
+    if (m_layout.use_count() > 1) {
+        return 0;
+    }
+    // Pages still shared with the copy this one was detached from are not its own
+    const Layout& layout = *m_layout;
+    size_t shared = (layout.rowSpan.getMemoryBytes() - layout.rowSpan.getMemoryBytes(true)) +
+                    (layout.colSpan.getMemoryBytes() - layout.colSpan.getMemoryBytes(true)) +
+                    (layout.nearestOpen.getMemoryBytes() - layout.nearestOpen.getMemoryBytes(true)) +
+                    (layout.openDistance.getMemoryBytes() - layout.openDistance.getMemoryBytes(true));
+    return getLayoutMemoryBytes() - shared;
+}
+
+std::uint64_t Maze::randomSeed() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32) ^ device();
 }
 
 void Maze::render(sf::RenderWindow& window) {
     sf::RectangleShape cell;
     cell.setSize(sf::Vector2f(CELL_SIZE, CELL_SIZE));
 
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            if (m_grid[y][x] == CELL_WALL) {
+    for (int y = 0; y < getGridHeight(); ++y) {
+        for (int x = 0; x < getGridWidth(); ++x) {
+            if (isWallUnchecked(x, y)) {
                 continue;
             }
             
-            bool isEdge = (x == 0 || x == GRID_WIDTH - 1 || y == 0 || y == GRID_HEIGHT - 1);
+            bool isEdge = !m_layout->endless && (x == 0 || x == getGridWidth() - 1 || y == 0 || y == getGridHeight() - 1);
             
             if (isEdge) {
                 const float doorThickness = CELL_SIZE / 2.0f;
@@ -31,13 +195,13 @@ void Maze::render(sf::RenderWindow& window) {
                 if (x == 0) {
                     door.setSize(sf::Vector2f(doorThickness, doorLength));
                     door.setPosition(sf::Vector2f(x * CELL_SIZE, centerY - doorLength / 2.0f));
-                } else if (x == GRID_WIDTH - 1) {
+                } else if (x == getGridWidth() - 1) {
                     door.setSize(sf::Vector2f(doorThickness, doorLength));
                     door.setPosition(sf::Vector2f(x * CELL_SIZE + CELL_SIZE - doorThickness, centerY - doorLength / 2.0f));
                 } else if (y == 0) {
                     door.setSize(sf::Vector2f(doorLength, doorThickness));
                     door.setPosition(sf::Vector2f(centerX - doorLength / 2.0f, y * CELL_SIZE));
-                } else if (y == GRID_HEIGHT - 1) {
+                } else if (y == getGridHeight() - 1) {
                     door.setSize(sf::Vector2f(doorLength, doorThickness));
                     door.setPosition(sf::Vector2f(centerX - doorLength / 2.0f, y * CELL_SIZE + CELL_SIZE - doorThickness));
                 }
@@ -59,16 +223,32 @@ void Maze::drawWallLines(sf::RenderWindow& window) {
     sf::RectangleShape line;
     line.setFillColor(WALL_COLOR);
 
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            if (m_grid[y][x] == CELL_WALL) {
+    // Masks only change with the cells, so they are rebuilt per version, not per frame
+    if (m_wallMaskVersion != m_layout->version) {
+        if (DefaultGrid::fits(*this)) {
+            DefaultGrid grid;
+            grid.load(*this);
+            buildWallMasks(grid, m_wallMasks);
+        } else {
+            DynamicGrid grid;
+            grid.load(*this);
+            buildWallMasks(grid, m_wallMasks);
+        }
+        m_wallMaskVersion = m_layout->version;
+    }
+
+    for (int y = 0; y < getGridHeight(); ++y) {
+        for (int x = 0; x < getGridWidth(); ++x) {
+            std::uint8_t mask = m_wallMasks[y * getGridWidth() + x];
+            if (mask & WALL_MASK_SELF) {
                 float centerX = x * CELL_SIZE + CELL_SIZE / 2.0f;
                 float centerY = y * CELL_SIZE + CELL_SIZE / 2.0f;
 
-                bool hasWallAbove = (y > 0 && m_grid[y - 1][x] == CELL_WALL);
-                bool hasWallRight = (x < GRID_WIDTH - 1 && m_grid[y][x + 1] == CELL_WALL);
-                bool hasWallBelow = (y < GRID_HEIGHT - 1 && m_grid[y + 1][x] == CELL_WALL);
-                bool hasWallLeft = (x > 0 && m_grid[y][x - 1] == CELL_WALL);
+                // The sentinel border counts as wall, so the masks leave it out at the edges
+                bool hasWallAbove = mask & WALL_MASK_ABOVE;
+                bool hasWallRight = mask & WALL_MASK_RIGHT;
+                bool hasWallBelow = mask & WALL_MASK_BELOW;
+                bool hasWallLeft = mask & WALL_MASK_LEFT;
 
                 if (!hasWallAbove && !hasWallRight && !hasWallBelow && !hasWallLeft) {
                     line.setSize(sf::Vector2f(CELL_SIZE * 0.8f, lineThickness));
@@ -107,89 +287,532 @@ void Maze::drawWallLines(sf::RenderWindow& window) {
 }
 
 bool Maze::isWall(int gridX, int gridY) const {
-    if (!isValidPosition(gridX, gridY))
-        return true;  
+    // The sentinel border covers one cell past each edge; only further out needs a check
+    if (static_cast<unsigned>(gridX + 1) > static_cast<unsigned>(getGridWidth() + 1) ||
+        static_cast<unsigned>(gridY + 1) > static_cast<unsigned>(getGridHeight() + 1))
+        return true;
 
-    return m_grid[gridY][gridX] == CELL_WALL;
+    return isWallUnchecked(gridX, gridY);
 }
 
 bool Maze::isValidPosition(int gridX, int gridY) const {
-    return gridX >= 0 && gridX < GRID_WIDTH &&
-           gridY >= 0 && gridY < GRID_HEIGHT;
+    return gridX >= 0 && gridX < getGridWidth() &&
+           gridY >= 0 && gridY < getGridHeight();
 }
 
-void Maze::generateDFS() {
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            m_grid[y][x] = CELL_WALL;
-        }
-    }
+void Maze::generate() {
+    const Generator& generator = getGenerator(m_layout->algorithm);
+    m_layout->cells.fill(CELL_WALL);
 
-    int centerX = GRID_WIDTH / 2;
-    int centerY = GRID_HEIGHT / 2;
-    dfsRecursive(centerX, centerY);
+    // Large DFS mazes are carved tile by tile on every core
+    const int logicalCells = (getGridWidth() / 2) * (getGridHeight() / 2);
+    if (m_layout->algorithm == MazeAlgorithm::DFS && logicalCells >= PARALLEL_GENERATION_MIN_CELLS) {
+        carveTiled(m_layout->cells, m_layout->seed, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    } else {
+        generator.carve(m_layout->cells, m_rng);
+    }
 
-    addBranchingPaths();
+    if (generator.perfect) {
+        addBranchingPaths();
+    }
 
     createExits();
+
+    if (!generator.perfect) {
+        joinComponents();
+    }
 }
 
-void Maze::dfsRecursive(int x, int y) {
-    // make current cell a path
-    m_grid[y][x] = CELL_EMPTY;
+void Maze::carveTiled(GridStorage& grid, std::uint64_t seed, int threadCount) {
+    const int mazeWidth = grid.getWidth() / 2;
+    const int mazeHeight = grid.getHeight() / 2;
+    const int tilesX = (mazeWidth + GENERATION_TILE_CELLS - 1) / GENERATION_TILE_CELLS;
+    const int tilesY = (mazeHeight + GENERATION_TILE_CELLS - 1) / GENERATION_TILE_CELLS;
+    const int tileCount = tilesX * tilesY;
+
+    // Logical cell range [first, last) covered by tile coordinate t along an axis
+    auto tileStart = [](int t) { return t * GENERATION_TILE_CELLS; };
+    auto tileEnd = [](int t, int cells) { return std::min((t + 1) * GENERATION_TILE_CELLS, cells); };
+
+    // Tiles write disjoint cells, so workers just claim the next unclaimed tile
+    std::atomic<int> nextTile(0);
+    auto carveTiles = [&]() {
+        for (int tile = nextTile++; tile < tileCount; tile = nextTile++) {
+            int tileX = tile % tilesX;
+            int tileY = tile / tilesX;
+            int firstX = tileStart(tileX);
+            int firstY = tileStart(tileY);
+            int width = tileEnd(tileX, mazeWidth) - firstX;
+            int height = tileEnd(tileY, mazeHeight) - firstY;
+
+            GridStorage local(width * 2 + 1, height * 2 + 1);
+            Random rng(Random::mix(seed ^ Random::mix(static_cast<std::uint64_t>(tile))));
+            carveDFS(local, (width / 2) * 2 + 1, (height / 2) * 2 + 1, rng);
+
+            for (int y = 1; y < height * 2; ++y) {
+                grid.writeRow(firstX * 2 + 1, firstY * 2 + y, local.row(y) + 1, width * 2 - 1);
+            }
+        }
+    };
 
+    std::vector<std::thread> workers;
+    for (int i = 1; i < std::min(threadCount, tileCount); ++i) {
+        workers.emplace_back(carveTiles);
+    }
+    carveTiles();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Stitch: a random spanning tree over the tile adjacency graph, one door per tree edge
+    struct Seam {
+        int tile;
+        bool horizontal;  ///< true = seam with the tile to the right, false = with the tile below
+    };
+    std::vector<Seam> seams;
+    for (int tile = 0; tile < tileCount; ++tile) {
+        if (tile % tilesX + 1 < tilesX) seams.push_back({tile, true});
+        if (tile / tilesX + 1 < tilesY) seams.push_back({tile, false});
+    }
+
+    Random rng(seed);
+    rng.shuffle(seams.begin(), seams.end());
+
+    UnionFind tiles(tileCount);
+    for (const Seam& seam : seams) {
+        int tileX = seam.tile % tilesX;
+        int tileY = seam.tile / tilesX;
+        int neighbor = seam.horizontal ? seam.tile + 1 : seam.tile + tilesX;
+        if (!tiles.unite(seam.tile, neighbor)) {
+            continue;
+        }
+
+        if (seam.horizontal) {
+            int row = rng.uniformInt(tileStart(tileY), tileEnd(tileY, mazeHeight) - 1);
+            grid.at(tileEnd(tileX, mazeWidth) * 2, row * 2 + 1) = CELL_EMPTY;
+        } else {
+            int column = rng.uniformInt(tileStart(tileX), tileEnd(tileX, mazeWidth) - 1);
+            grid.at(column * 2 + 1, tileEnd(tileY, mazeHeight) * 2) = CELL_EMPTY;
+        }
+    }
+}
+
+void Maze::carveDFS(GridStorage& grid, int startX, int startY, Random& rng) {
     // up, down, left, right (2 cells away)
-    int directions[4][2] = {{0, -2}, {0, 2}, {-2, 0}, {2, 0}};
+    static const int directions[4][2] = {{0, -2}, {0, 2}, {-2, 0}, {2, 0}};
 
-    std::shuffle(std::begin(directions), std::end(directions), m_rng);
+    // One frame per carved cell on the current branch; replaces the call stack
+    struct Frame {
+        int x, y;
+        std::uint8_t order[4];  ///< Shuffled direction indices
+        std::int8_t next;       ///< Next direction to try
+        std::int8_t pending;    ///< Direction of the child just descended into (-1 = none)
+    };
 
-    for (int i = 0; i < 4; ++i) {
-        int newX = x + directions[i][0];
-        int newY = y + directions[i][1];
+    auto enter = [&](std::vector<Frame>& stack, int x, int y) {
+        // make current cell a path
+        grid.at(x, y) = CELL_EMPTY;
+        Frame frame{x, y, {0, 1, 2, 3}, 0, -1};
+        rng.shuffle(std::begin(frame.order), std::end(frame.order));
+        stack.push_back(frame);
+    };
 
-        // if new position is valid and unvisited
-        if (isValidPosition(newX, newY) && m_grid[newY][newX] == CELL_WALL) {
-            int wallX = x + directions[i][0] / 2;
-            int wallY = y + directions[i][1] / 2;
-            m_grid[wallY][wallX] = CELL_EMPTY;
+    auto isUnvisited = [&](int x, int y) {
+        return x >= 0 && x < grid.getWidth() && y >= 0 && y < grid.getHeight() && grid.get(x, y) == CELL_WALL;
+    };
 
-            dfsRecursive(newX, newY);
-            
-            std::uniform_int_distribution<int> extraPath(0, 99);
-            if (extraPath(m_rng) < 10) {  
-                for (int j = i + 1; j < 4; ++j) {
-                    int extraX = x + directions[j][0];
-                    int extraY = y + directions[j][1];
-                    
-                    if (isValidPosition(extraX, extraY) && m_grid[extraY][extraX] == CELL_WALL) {
-                        int extraWallX = x + directions[j][0] / 2;
-                        int extraWallY = y + directions[j][1] / 2;
-                        m_grid[extraWallY][extraWallX] = CELL_EMPTY;
-                        break;  
+    // Depth is bounded by the number of logical cells, so the stack never reallocates
+    std::vector<Frame> stack;
+    stack.reserve(static_cast<size_t>(grid.getWidth() / 2 + 1) * (grid.getHeight() / 2 + 1));
+    enter(stack, startX, startY);
+
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+
+        // Back from a child: occasionally open a second passage to a later unvisited neighbor
+        if (frame.pending >= 0) {
+            if (rng.chance(10)) {
+                for (int j = frame.pending + 1; j < 4; ++j) {
+                    const int* dir = directions[frame.order[j]];
+                    if (isUnvisited(frame.x + dir[0], frame.y + dir[1])) {
+                        grid.at(frame.x + dir[0] / 2, frame.y + dir[1] / 2) = CELL_EMPTY;
+                        break;
                     }
                 }
             }
+            frame.pending = -1;
+        }
+
+        if (frame.next == 4) {
+            stack.pop_back();
+            continue;
+        }
+
+        int i = frame.next++;
+        const int* dir = directions[frame.order[i]];
+        int newX = frame.x + dir[0];
+        int newY = frame.y + dir[1];
+
+        // if new position is valid and unvisited
+        if (isUnvisited(newX, newY)) {
+            grid.at(frame.x + dir[0] / 2, frame.y + dir[1] / 2) = CELL_EMPTY;
+            frame.pending = static_cast<std::int8_t>(i);
+            enter(stack, newX, newY);  // invalidates frame
         }
     }
 }
 
-void Maze::addBranchingPaths() {
-    std::uniform_int_distribution<int> branchChance(0, 99);
-    std::uniform_int_distribution<int> wallX(1, GRID_WIDTH - 2);
-    std::uniform_int_distribution<int> wallY(1, GRID_HEIGHT - 2);
+const std::vector<Maze::Generator>& Maze::getGenerators() {
+    // DFS starts from the logical cell nearest the grid center (odd coordinates, also for even maze sizes)
+    static const std::vector<Generator> generators = {
+        {MazeAlgorithm::DFS, "dfs",
+         [](GridStorage& grid, Random& rng) { carveDFS(grid, (grid.getWidth() / 2) | 1, (grid.getHeight() / 2) | 1, rng); },
+         true},
+        {MazeAlgorithm::KRUSKAL, "kruskal", carveKruskal, true},
+        {MazeAlgorithm::PRIM, "prim", carvePrim, true},
+        {MazeAlgorithm::WILSON, "wilson", carveWilson, true},
+        {MazeAlgorithm::CAVES, "caves", carveCaves, false},
+    };
+    return generators;
+}
+
+const Maze::Generator& Maze::getGenerator(MazeAlgorithm algorithm) {
+    return getGenerators()[static_cast<int>(algorithm)];
+}
+
+const Maze::Generator* Maze::findGenerator(const std::string& name) {
+    for (const auto& generator : getGenerators()) {
+        if (name == generator.name) {
+            return &generator;
+        }
+    }
+    return nullptr;
+}
+
+void Maze::carveKruskal(GridStorage& grid, Random& rng) {
+    const int mazeWidth = grid.getWidth() / 2;
+    const int mazeHeight = grid.getHeight() / 2;
+    if (mazeWidth <= 0 || mazeHeight <= 0) {
+        return;
+    }
+
+    // Wall ids: cell * 2 opens to the right neighbor, cell * 2 + 1 to the one below
+    std::vector<std::uint32_t> walls;
+    walls.reserve(static_cast<size_t>(mazeWidth) * mazeHeight * 2);
+    for (int y = 0; y < mazeHeight; ++y) {
+        for (int x = 0; x < mazeWidth; ++x) {
+            std::uint32_t cell = static_cast<std::uint32_t>(y) * mazeWidth + x;
+            grid.at(x * 2 + 1, y * 2 + 1) = CELL_EMPTY;
+            if (x + 1 < mazeWidth) walls.push_back(cell * 2);
+            if (y + 1 < mazeHeight) walls.push_back(cell * 2 + 1);
+        }
+    }
+    rng.shuffle(walls.begin(), walls.end());
+
+    UnionFind cells(mazeWidth * mazeHeight);
+    for (std::uint32_t wall : walls) {
+        int cell = static_cast<int>(wall / 2);
+        bool down = wall & 1;
+        int other = down ? cell + mazeWidth : cell + 1;
+        if (cells.unite(cell, other)) {
+            int x = cell % mazeWidth;
+            int y = cell / mazeWidth;
+            grid.at(x * 2 + 1 + (down ? 0 : 1), y * 2 + 1 + (down ? 1 : 0)) = CELL_EMPTY;
+        }
+        if (cells.getSetCount() == 1) {
+            break;
+        }
+    }
+}
+
+void Maze::carvePrim(GridStorage& grid, Random& rng) {
+    const int mazeWidth = grid.getWidth() / 2;
+    const int mazeHeight = grid.getHeight() / 2;
+    if (mazeWidth <= 0 || mazeHeight <= 0) {
+        return;
+    }
+    static const int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    enum : std::uint8_t { OUTSIDE, FRONTIER, INSIDE };
+    std::vector<std::uint8_t> state(static_cast<size_t>(mazeWidth) * mazeHeight, OUTSIDE);
+    std::vector<int> frontier;
+
+    auto add = [&](int x, int y) {
+        state[y * mazeWidth + x] = INSIDE;
+        grid.at(x * 2 + 1, y * 2 + 1) = CELL_EMPTY;
+        for (const auto& dir : directions) {
+            int newX = x + dir[0];
+            int newY = y + dir[1];
+            if (newX < 0 || newX >= mazeWidth || newY < 0 || newY >= mazeHeight) continue;
+            std::uint8_t& neighbor = state[newY * mazeWidth + newX];
+            if (neighbor == OUTSIDE) {
+                neighbor = FRONTIER;
+                frontier.push_back(newY * mazeWidth + newX);
+            }
+        }
+    };
+
+    add(mazeWidth / 2, mazeHeight / 2);
+    while (!frontier.empty()) {
+        // Swap-remove a random frontier cell
+        int pick = rng.uniformInt(0, static_cast<int>(frontier.size()) - 1);
+        int cell = frontier[pick];
+        frontier[pick] = frontier.back();
+        frontier.pop_back();
+
+        int x = cell % mazeWidth;
+        int y = cell / mazeWidth;
+        int inside[4];
+        int insideCount = 0;
+        for (int i = 0; i < 4; ++i) {
+            int newX = x + directions[i][0];
+            int newY = y + directions[i][1];
+            if (newX >= 0 && newX < mazeWidth && newY >= 0 && newY < mazeHeight &&
+                state[newY * mazeWidth + newX] == INSIDE) {
+                inside[insideCount++] = i;
+            }
+        }
+
+        const int* dir = directions[inside[rng.uniformInt(0, insideCount - 1)]];
+        grid.at(x * 2 + 1 + dir[0], y * 2 + 1 + dir[1]) = CELL_EMPTY;
+        add(x, y);
+    }
+}
+
+void Maze::carveWilson(GridStorage& grid, Random& rng) {
+    const int mazeWidth = grid.getWidth() / 2;
+    const int mazeHeight = grid.getHeight() / 2;
+    if (mazeWidth <= 0 || mazeHeight <= 0) {
+        return;
+    }
+    static const int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    const std::uint8_t IN_TREE = 4;
+
+    // Per cell: IN_TREE, or the direction the current walk last left it by
+    std::vector<std::uint8_t> exits(static_cast<size_t>(mazeWidth) * mazeHeight, 0);
+    auto inTree = [&](int cell) { return exits[cell] == IN_TREE; };
+
+    int root = (mazeHeight / 2) * mazeWidth + mazeWidth / 2;
+    exits[root] = IN_TREE;
+    grid.at((root % mazeWidth) * 2 + 1, (root / mazeWidth) * 2 + 1) = CELL_EMPTY;
+
+    for (int start = 0; start < mazeWidth * mazeHeight; ++start) {
+        if (inTree(start)) {
+            continue;
+        }
+
+        // Random walk until the tree is hit; overwriting exits erases loops
+        int cell = start;
+        while (!inTree(cell)) {
+            int x = cell % mazeWidth;
+            int y = cell / mazeWidth;
+            int dir;
+            int newX;
+            int newY;
+            do {
+                dir = rng.uniformInt(0, 3);
+                newX = x + directions[dir][0];
+                newY = y + directions[dir][1];
+            } while (newX < 0 || newX >= mazeWidth || newY < 0 || newY >= mazeHeight);
+            exits[cell] = static_cast<std::uint8_t>(dir);
+            cell = newY * mazeWidth + newX;
+        }
+
+        // Retrace the loop-erased path, carving it into the tree
+        cell = start;
+        while (!inTree(cell)) {
+            int x = cell % mazeWidth;
+            int y = cell / mazeWidth;
+            const int* dir = directions[exits[cell]];
+            exits[cell] = IN_TREE;
+            grid.at(x * 2 + 1, y * 2 + 1) = CELL_EMPTY;
+            grid.at(x * 2 + 1 + dir[0], y * 2 + 1 + dir[1]) = CELL_EMPTY;
+            cell = (y + dir[1]) * mazeWidth + x + dir[0];
+        }
+    }
+}
+
+void Maze::carveCaves(GridStorage& grid, Random& rng) {
+    const int gridWidth = grid.getWidth();
+    const int gridHeight = grid.getHeight();
+
+    BitGrid walls(gridWidth, gridHeight);
+    BitGrid next;
+    const std::uint64_t lastMask = walls.getLastWordMask();
+    for (int y = 0; y < gridHeight; ++y) {
+        std::uint64_t* row = walls.row(y);
+        for (int word = 0; word < walls.getWordsPerRow(); ++word) {
+            row[word] = randomBits(rng, CAVE_WALL_PERCENT);
+        }
+        row[walls.getWordsPerRow() - 1] &= lastMask;
+    }
+
+    for (int step = 0; step < CAVE_SMOOTHING_STEPS; ++step) {
+        stepLifeLike(walls, next, CAVE_BIRTH_MASK, CAVE_SURVIVE_MASK, true);
+        std::swap(walls, next);
+    }
+
+    for (int y = 1; y < gridHeight - 1; ++y) {
+        for (int x = 1; x < gridWidth - 1; ++x) {
+            grid.at(x, y) = walls.get(x, y) ? CELL_WALL : CELL_EMPTY;
+        }
+    }
+
+    // Clear the start area in the center
+    const int centerX = gridWidth / 2;
+    const int centerY = gridHeight / 2;
+    for (int y = std::max(1, centerY - 2); y <= std::min(gridHeight - 2, centerY + 2); ++y) {
+        for (int x = std::max(1, centerX - 2); x <= std::min(gridWidth - 2, centerX + 2); ++x) {
+            grid.at(x, y) = CELL_EMPTY;
+        }
+    }
+}
+
+void Maze::streamEller(int mazeWidth, int mazeHeight, Random& rng, const RowConsumer& emitRow) {
+    const int gridWidth = mazeWidth * 2 + 1;
+
+    // Pick two distinct exits up front, from the same border slots createExits uses
+    const int lastSlot = 2 * mazeWidth + 2 * mazeHeight - 1;
+    int exits[2] = {rng.uniformInt(0, lastSlot), 0};
+    do {
+        exits[1] = rng.uniformInt(0, lastSlot);
+    } while (exits[1] == exits[0]);
+
+    auto isExit = [&](int slot) { return slot == exits[0] || slot == exits[1]; };
+    const int topSlot = 0;
+    const int bottomSlot = mazeWidth;
+    const int leftSlot = 2 * mazeWidth;
+    const int rightSlot = 2 * mazeWidth + mazeHeight;
+
+    // Row state: the set label of each column and a per-row union-find over columns
+    std::vector<int> label(mazeWidth, -1);
+    std::vector<int> parent(mazeWidth);
+    std::vector<int> firstColumn(mazeWidth, -1);
+    std::vector<std::uint8_t> hasDown(mazeWidth);
+    std::vector<int> chosen(mazeWidth);
+    std::vector<int> seen(mazeWidth);
+    std::vector<std::uint8_t> row(gridWidth);
 
+    auto find = [&](int column) {
+        while (parent[column] != column) {
+            parent[column] = parent[parent[column]];
+            column = parent[column];
+        }
+        return column;
+    };
+
+
+    // Top border
+    std::fill(row.begin(), row.end(), CELL_WALL);
+    for (int c = 0; c < mazeWidth; ++c) {
+        if (isExit(topSlot + c)) row[c * 2 + 1] = CELL_EMPTY;
+    }
+    emitRow(0, row.data(), gridWidth);
+
+    for (int r = 0; r < mazeHeight; ++r) {
+        bool lastRow = r == mazeHeight - 1;
+
+        // Columns carried down from the previous row start out joined; the rest are new sets
+        std::iota(parent.begin(), parent.end(), 0);
+        for (int c = 0; c < mazeWidth; ++c) {
+            if (label[c] < 0) continue;
+            if (firstColumn[label[c]] < 0) {
+                firstColumn[label[c]] = c;
+            } else {
+                parent[c] = firstColumn[label[c]];
+            }
+        }
+        for (int c = 0; c < mazeWidth; ++c) {
+            if (label[c] >= 0) firstColumn[label[c]] = -1;
+        }
+
+        // Cell row: open cells, randomly join neighbors in different sets (always on the last row)
+        std::fill(row.begin(), row.end(), CELL_WALL);
+        if (isExit(leftSlot + r)) row[0] = CELL_EMPTY;
+        if (isExit(rightSlot + r)) row[gridWidth - 1] = CELL_EMPTY;
+        for (int c = 0; c < mazeWidth; ++c) {
+            row[c * 2 + 1] = CELL_EMPTY;
+            if (c + 1 < mazeWidth) {
+                int a = find(c);
+                int b = find(c + 1);
+                if (a != b && (lastRow || rng.chance(50))) {
+                    parent[b] = a;
+                    row[c * 2 + 2] = CELL_EMPTY;
+                }
+            }
+        }
+        emitRow(r * 2 + 1, row.data(), gridWidth);
+
+        // South row: each set continues down at least once (reservoir-sample one column per set)
+        std::fill(row.begin(), row.end(), CELL_WALL);
+        if (lastRow) {
+            for (int c = 0; c < mazeWidth; ++c) {
+                if (isExit(bottomSlot + c)) row[c * 2 + 1] = CELL_EMPTY;
+            }
+            emitRow(r * 2 + 2, row.data(), gridWidth);
+            break;
+        }
+
+        std::fill(seen.begin(), seen.end(), 0);
+        for (int c = 0; c < mazeWidth; ++c) {
+            int root = find(c);
+            hasDown[c] = static_cast<std::uint8_t>(rng.chance(50));
+            seen[root]++;
+            if (rng.uniformInt(1, seen[root]) == 1) {
+                chosen[root] = c;
+            }
+        }
+        for (int c = 0; c < mazeWidth; ++c) {
+            int root = find(c);
+            if (seen[root] > 0) {
+                hasDown[chosen[root]] = 1;
+                seen[root] = 0;  // Handled
+            }
+        }
+
+        for (int c = 0; c < mazeWidth; ++c) {
+            if (hasDown[c]) {
+                row[c * 2 + 1] = CELL_EMPTY;
+                label[c] = find(c);  // Root columns are distinct labels in [0, mazeWidth)
+            } else {
+                label[c] = -1;
+            }
+        }
+        emitRow(r * 2 + 2, row.data(), gridWidth);
+    }
+}
+
+void Maze::regenerateEller() {
+    regenerateEller(randomSeed());
+}
+
+void Maze::regenerateEller(std::uint64_t seed) {
+    detach(false);
+    m_layout->endless = false;
+    m_layout->seed = seed;
+    m_rng.reseed(seed);
+
+    streamEller((getGridWidth() - 1) / 2, (getGridHeight() - 1) / 2, m_rng,
+                [this](int gridY, const std::uint8_t* row, int gridWidth) {
+                    m_layout->cells.writeRow(0, gridY, row, gridWidth);
+                });
+
+    rebuildDerivedData();
+}
+
+void Maze::addBranchingPaths() {
     int attempts = 0;
-    int maxAttempts = (GRID_WIDTH * GRID_HEIGHT) / 4;  // 25% of all cells
+    int maxAttempts = (getGridWidth() * getGridHeight()) / 4;  // 25% of all cells
 
     while (attempts < maxAttempts) {
-        int x = wallX(m_rng);
-        int y = wallY(m_rng);
+        int x = m_rng.uniformInt(1, getGridWidth() - 2);
+        int y = m_rng.uniformInt(1, getGridHeight() - 2);
 
-        if (m_grid[y][x] == CELL_WALL &&
+        if (at(x, y) == CELL_WALL &&
             isSurroundedByPaths(x, y) &&
             !isCornerPiece(x, y) &&
-            branchChance(m_rng) < 25) {  // 25% chance
-            m_grid[y][x] = CELL_EMPTY;
+            m_rng.chance(25)) {
+            at(x, y) = CELL_EMPTY;
         }
 
         attempts++;
@@ -199,20 +822,20 @@ void Maze::addBranchingPaths() {
 bool Maze::isSurroundedByPaths(int x, int y) const {
     int pathCount = 0;
 
-    if (x > 0 && m_grid[y][x - 1] == CELL_EMPTY) pathCount++;
-    if (x < GRID_WIDTH - 1 && m_grid[y][x + 1] == CELL_EMPTY) pathCount++;
-    if (y > 0 && m_grid[y - 1][x] == CELL_EMPTY) pathCount++;
-    if (y < GRID_HEIGHT - 1 && m_grid[y + 1][x] == CELL_EMPTY) pathCount++;
+    if (x > 0 && at(x - 1, y) == CELL_EMPTY) pathCount++;
+    if (x < getGridWidth() - 1 && at(x + 1, y) == CELL_EMPTY) pathCount++;
+    if (y > 0 && at(x, y - 1) == CELL_EMPTY) pathCount++;
+    if (y < getGridHeight() - 1 && at(x, y + 1) == CELL_EMPTY) pathCount++;
 
     return pathCount >= 2;
 }
 
 bool Maze::isCornerPiece(int x, int y) const {
     
-    bool hasWallAbove = (y > 0 && m_grid[y - 1][x] == CELL_WALL);
-    bool hasWallRight = (x < GRID_WIDTH - 1 && m_grid[y][x + 1] == CELL_WALL);
-    bool hasWallBelow = (y < GRID_HEIGHT - 1 && m_grid[y + 1][x] == CELL_WALL);
-    bool hasWallLeft = (x > 0 && m_grid[y][x - 1] == CELL_WALL);
+    bool hasWallAbove = (y > 0 && at(x, y - 1) == CELL_WALL);
+    bool hasWallRight = (x < getGridWidth() - 1 && at(x + 1, y) == CELL_WALL);
+    bool hasWallBelow = (y < getGridHeight() - 1 && at(x, y + 1) == CELL_WALL);
+    bool hasWallLeft = (x > 0 && at(x - 1, y) == CELL_WALL);
     
     int wallCount = 0;
     if (hasWallAbove) wallCount++;
@@ -235,67 +858,952 @@ void Maze::createExits() {
 
     std::vector<std::pair<int, int>> borderPositions;
 
-    for (int x = 1; x < GRID_WIDTH - 1; x += 2) {
+    for (int x = 1; x < getGridWidth() - 1; x += 2) {
         borderPositions.push_back({x, 0});
-        borderPositions.push_back({x, GRID_HEIGHT - 1});
+        borderPositions.push_back({x, getGridHeight() - 1});
     }
 
-    for (int y = 1; y < GRID_HEIGHT - 1; y += 2) {
+    for (int y = 1; y < getGridHeight() - 1; y += 2) {
         borderPositions.push_back({0, y});
-        borderPositions.push_back({GRID_WIDTH - 1, y});
+        borderPositions.push_back({getGridWidth() - 1, y});
     }
 
     // Shuffle and pick random exits
-    std::shuffle(borderPositions.begin(), borderPositions.end(), m_rng);
+    m_rng.shuffle(borderPositions.begin(), borderPositions.end());
 
     for (int i = 0; i < exitCount && i < borderPositions.size(); ++i) {
         int exitX = borderPositions[i].first;
         int exitY = borderPositions[i].second;
 
-        m_grid[exitY][exitX] = CELL_EMPTY;
+        at(exitX, exitY) = CELL_EMPTY;
     }
 }
 
-void Maze::generateRandomWalls() {
-    for (int x = 0; x < GRID_WIDTH; ++x) {
-        m_grid[0][x] = CELL_WALL;
-        m_grid[GRID_HEIGHT - 1][x] = CELL_WALL;
+int Maze::regenerateRandomWalls(std::uint64_t seed) {
+    detach(false);
+    m_layout->endless = false;
+    m_layout->seed = seed;
+    m_rng.reseed(seed);
+
+    generateRandomWalls();
+    createExits();
+    return ensureConnectivity();
+}
+
+void Maze::addRandomOpenAreas() {
+    detach(true);
+
+    const int gridWidth = getGridWidth();
+    const int gridHeight = getGridHeight();
+    const int areaCount = std::max(1, gridWidth * gridHeight / OPEN_AREA_CELLS_PER_AREA);
+
+    for (int i = 0; i < areaCount; ++i) {
+        int width = m_rng.uniformInt(OPEN_AREA_MIN_SIZE, OPEN_AREA_MAX_SIZE);
+        int height = m_rng.uniformInt(OPEN_AREA_MIN_SIZE, OPEN_AREA_MAX_SIZE);
+        int left = m_rng.uniformInt(1, std::max(1, gridWidth - 1 - width));
+        int top = m_rng.uniformInt(1, std::max(1, gridHeight - 1 - height));
+
+        for (int y = top; y < std::min(top + height, gridHeight - 1); ++y) {
+            for (int x = left; x < std::min(left + width, gridWidth - 1); ++x) {
+                at(x, y) = CELL_EMPTY;
+            }
+        }
     }
+}
+
+int Maze::ensureConnectivity() {
+    detach(true);
+    int components = joinComponents();
+    rebuildDerivedData();
+    return components;
+}
 
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        m_grid[y][0] = CELL_WALL;
-        m_grid[y][GRID_WIDTH - 1] = CELL_WALL;
+int Maze::joinComponents() {
+    const int gridWidth = getGridWidth();
+    const int gridHeight = getGridHeight();
+    const int cellCount = gridWidth * gridHeight;
+
+    // Label open cells: union each with its right and lower open neighbor
+    UnionFind cells(cellCount);
+    int wallCount = 0;
+    std::vector<std::uint8_t> rowBuffer;
+    std::vector<std::uint8_t> belowBuffer;
+    const std::uint8_t* below = readRow(0, belowBuffer);
+    for (int y = 0; y < gridHeight; ++y) {
+        // Swapping keeps a gathered row in place, so the row below becomes this
+        // row without a copy. Below the last row is the sentinel wall border.
+        std::swap(rowBuffer, belowBuffer);
+        const std::uint8_t* row = below;
+        below = readRow(y + 1, belowBuffer);
+        for (int x = 0; x < gridWidth; ++x) {
+            if (row[x] != CELL_EMPTY) {
+                wallCount++;
+                continue;
+            }
+            int index = y * gridWidth + x;
+            if (row[x + 1] == CELL_EMPTY) cells.unite(index, index + 1);
+            if (below[x] == CELL_EMPTY) cells.unite(index, index + gridWidth);
+        }
     }
 
-    std::uniform_int_distribution<int> wallChance(0, 9);
+    // Every wall is still a singleton set
+    const int components = cells.getSetCount() - wallCount;
+    if (components <= 1) {
+        return components;
+    }
 
-    for (int y = 1; y < GRID_HEIGHT - 1; ++y) {
-        for (int x = 1; x < GRID_WIDTH - 1; ++x) {
-            if (wallChance(m_rng) < 3)  // 30% chance
-            {
-                m_grid[y][x] = CELL_WALL;
+    // Grow all components through the interior walls at once. Where two fronts
+    // meet, joining them costs the walls on both back-pointer chains.
+    std::vector<int> distance(cellCount, -1);
+    std::vector<int> parent(cellCount, -1);
+    std::vector<int> owner(cellCount, -1);
+    std::vector<int> queue;
+    queue.reserve(cellCount);
+    for (int y = 0; y < gridHeight; ++y) {
+        const std::uint8_t* row = readRow(y, rowBuffer);
+        for (int x = 0; x < gridWidth; ++x) {
+            if (row[x] == CELL_EMPTY) {
+                int index = y * gridWidth + x;
+                distance[index] = 0;
+                owner[index] = cells.find(index);
+                queue.push_back(index);
             }
         }
     }
 
-    int centerX = GRID_WIDTH / 2;
-    int centerY = GRID_HEIGHT / 2;
+    struct Bridge {
+        int cost;  ///< Walls carved by this bridge
+        int from;  ///< Last cell of one component's chain
+        int to;    ///< Last cell of the other component's chain
+    };
+    std::vector<Bridge> bridges;
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int index = queue[head];
+        int x = index % gridWidth;
+        int y = index / gridWidth;
+
+        for (int i = 0; i < 4; ++i) {
+            int newX = x + directions[i][0];
+            int newY = y + directions[i][1];
+            if (!isValidPosition(newX, newY)) {
+                continue;
+            }
+
+            int newIndex = newY * gridWidth + newX;
+            if (owner[newIndex] >= 0) {
+                if (owner[newIndex] != owner[index]) {
+                    bridges.push_back({distance[index] + distance[newIndex], index, newIndex});
+                }
+                continue;
+            }
+
+            bool interior = newX > 0 && newY > 0 && newX < gridWidth - 1 && newY < gridHeight - 1;
+            if (interior) {
+                distance[newIndex] = distance[index] + 1;
+                parent[newIndex] = index;
+                owner[newIndex] = owner[index];
+                queue.push_back(newIndex);
+            }
+        }
+    }
+
+    // Kruskal over components; stable so equal-cost ties resolve the same on every platform
+    std::stable_sort(bridges.begin(), bridges.end(),
+                     [](const Bridge& a, const Bridge& b) { return a.cost < b.cost; });
+
+    auto carveChain = [&](int index) {
+        for (; index >= 0 && at(index % gridWidth, index / gridWidth) == CELL_WALL; index = parent[index]) {
+            at(index % gridWidth, index / gridWidth) = CELL_EMPTY;
+        }
+    };
+
+    for (const Bridge& bridge : bridges) {
+        if (cells.unite(owner[bridge.from], owner[bridge.to])) {
+            carveChain(bridge.from);
+            carveChain(bridge.to);
+        }
+    }
+
+    return components;
+}
+
+void Maze::generateRandomWalls() {
+    for (int x = 0; x < getGridWidth(); ++x) {
+        at(x, 0) = CELL_WALL;
+        at(x, getGridHeight() - 1) = CELL_WALL;
+    }
+
+    for (int y = 0; y < getGridHeight(); ++y) {
+        at(0, y) = CELL_WALL;
+        at(getGridWidth() - 1, y) = CELL_WALL;
+    }
+
+    for (int y = 1; y < getGridHeight() - 1; ++y) {
+        for (int x = 1; x < getGridWidth() - 1; ++x) {
+            at(x, y) = m_rng.chance(RANDOM_WALL_PERCENT) ? CELL_WALL : CELL_EMPTY;
+        }
+    }
+
+    int centerX = getGridWidth() / 2;
+    int centerY = getGridHeight() / 2;
 
     for (int y = centerY - 2; y <= centerY + 2; ++y) {
         for (int x = centerX - 2; x <= centerX + 2; ++x) {
             if (isValidPosition(x, y)) {
-                m_grid[y][x] = CELL_EMPTY;
+                at(x, y) = CELL_EMPTY;
             }
         }
     }
 }
 
 void Maze::regenerate() {
-    for (int y = 0; y < GRID_HEIGHT; ++y) {
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            m_grid[y][x] = CELL_WALL;
+    regenerate(randomSeed());
+}
+
+void Maze::regenerate(std::uint64_t seed) {
+    regenerate(seed, getAlgorithm());
+}
+
+void Maze::regenerate(std::uint64_t seed, MazeAlgorithm algorithm) {
+    detach(false);
+    m_layout->endless = false;
+    m_layout->seed = seed;
+    m_layout->algorithm = algorithm;
+    m_rng.reseed(seed);
+
+    generate();
+    rebuildDerivedData();
+}
+
+void Maze::loadWindow(ChunkCache& chunks, std::int64_t originX, std::int64_t originY) {
+    detach(false);
+    m_layout->endless = true;
+    m_layout->originX = originX;
+    m_layout->originY = originY;
+
+    // Copy one chunk-sized block at a time so each chunk is looked up once
+    const int chunkSize = ChunkCache::chunkGridSize();
+    for (int y = 0; y < getGridHeight();) {
+        std::int64_t worldY = originY + y;
+        std::int64_t chunkY = ChunkCache::chunkOf(worldY);
+        int localY = static_cast<int>(worldY - chunkY * chunkSize);
+        int rows = std::min(chunkSize - localY, getGridHeight() - y);
+
+        for (int x = 0; x < getGridWidth();) {
+            std::int64_t worldX = originX + x;
+            std::int64_t chunkX = ChunkCache::chunkOf(worldX);
+            int localX = static_cast<int>(worldX - chunkX * chunkSize);
+            int columns = std::min(chunkSize - localX, getGridWidth() - x);
+
+            auto chunk = chunks.getChunk(chunkX, chunkY);
+            for (int row = 0; row < rows; ++row) {
+                m_layout->cells.writeRow(x, y + row, &chunk->cells[(localY + row) * chunkSize + localX], columns);
+            }
+            x += columns;
+        }
+        y += rows;
+    }
+
+    rebuildDerivedData();
+}
+
+bool Maze::hasLineOfSight(int x1, int y1, int x2, int y2) const {
+    if (!isValidPosition(x1, y1) || !isValidPosition(x2, y2)) {
+        return false;
+    }
+
+    int index1 = y1 * getGridWidth() + x1;
+    int index2 = y2 * getGridWidth() + x2;
+
+    if (y1 == y2) {
+        return m_layout->rowSpan[index1] >= 0 && m_layout->rowSpan[index1] == m_layout->rowSpan[index2];
+    }
+    if (x1 == x2) {
+        return m_layout->colSpan[index1] >= 0 && m_layout->colSpan[index1] == m_layout->colSpan[index2];
+    }
+    return false;
+}
+
+size_t Maze::getVisibilityMemoryBytes() const {
+    return m_layout->rowSpan.getMemoryBytes() + m_layout->colSpan.getMemoryBytes();
+}
+
+void Maze::rebuildDerivedData() {
+    detach(true);
+
+    buildVisibility();
+    buildDistanceTransform();
+    buildAnalysis();
+    m_layout->analysisStale = false;
+
+    m_layout->version = nextVersion.fetch_add(1);
+    m_layout->logBase = m_layout->version;
+    m_layout->editLog.clear();
+}
+
+bool Maze::setCell(int gridX, int gridY, std::uint8_t value) {
+    return applyEdits({{gridX, gridY, value}}) > 0;
+}
+
+int Maze::applyEdits(const std::vector<CellEdit>& edits) {
+    // Only a real change is worth giving up a shared layout for
+    bool anyChange = std::any_of(edits.begin(), edits.end(), [this](const CellEdit& edit) {
+        return isValidPosition(edit.x, edit.y) && m_layout->cells.get(edit.x, edit.y) != edit.value;
+    });
+    if (!anyChange) {
+        return 0;
+    }
+    detach(true);
+
+    DirtyRegion region{getGridWidth(), getGridHeight(), -1, -1};
+    int changed = 0;
+    for (const auto& edit : edits) {
+        if (!isValidPosition(edit.x, edit.y) || at(edit.x, edit.y) == edit.value) {
+            continue;
+        }
+        at(edit.x, edit.y) = edit.value;
+        region.left = std::min(region.left, edit.x);
+        region.top = std::min(region.top, edit.y);
+        region.right = std::max(region.right, edit.x);
+        region.bottom = std::max(region.bottom, edit.y);
+        changed++;
+    }
+    if (changed == 0) {
+        return 0;
+    }
+
+    // A cell only affects the spans of its own row and column
+    for (int y = region.top; y <= region.bottom; ++y) {
+        labelRowSpans(y);
+    }
+    for (int x = region.left; x <= region.right; ++x) {
+        labelColumnSpans(x);
+    }
+    updateDistanceTransform(region);
+    m_layout->analysisStale = true;
+
+    m_layout->version = nextVersion.fetch_add(1);
+    m_layout->editLog.push_back({m_layout->version, region});
+    if (m_layout->editLog.size() > static_cast<size_t>(MAZE_EDIT_LOG_SIZE)) {
+        m_layout->logBase = m_layout->editLog.front().version;
+        m_layout->editLog.pop_front();
+    }
+    return changed;
+}
+
+bool Maze::getDirtySince(std::uint64_t version, DirtyRegion& region) const {
+    region = DirtyRegion();
+    if (version == m_layout->version) {
+        return true;
+    }
+    if (version < m_layout->logBase || version > m_layout->version) {
+        return false;
+    }
+
+    bool known = version == m_layout->logBase;
+    for (const auto& record : m_layout->editLog) {
+        if (record.version == version) {
+            known = true;
+            continue;
+        }
+        if (record.version < version) {
+            continue;
+        }
+        if (region.isEmpty()) {
+            region = record.region;
+            continue;
+        }
+        region.left = std::min(region.left, record.region.left);
+        region.top = std::min(region.top, record.region.top);
+        region.right = std::max(region.right, record.region.right);
+        region.bottom = std::max(region.bottom, record.region.bottom);
+    }
+    // Versions are shared between mazes, so one inside the range may belong to another maze
+    return known;
+}
+
+void Maze::buildAnalysis() const {
+    const int gridWidth = getGridWidth();
+    const int cellCount = gridWidth * getGridHeight();
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    m_layout->cellKinds.assign(cellCount, CellKind::WALL);
+    m_layout->startDistance.assign(cellCount, -1);
+    // Clear rather than replace the indices so repeated rebuilds reuse their capacity
+    m_layout->reachable.cells.clear();
+    m_layout->reachable.firstAtDistance.clear();
+    for (auto& index : m_layout->byKind) {
+        index.cells.clear();
+        index.firstAtDistance.clear();
+    }
+    buildChokepoints();
+
+    // Border openings are exits, except on an endless-mode window where they lead on
+    auto classify = [&](int x, int y, int openNeighbors) {
+        bool onBorder = x == 0 || y == 0 || x == gridWidth - 1 || y == getGridHeight() - 1;
+        if (onBorder && !m_layout->endless) return CellKind::EXIT;
+        if (openNeighbors >= 3) return CellKind::JUNCTION;
+        if (openNeighbors == 2) return CellKind::CORRIDOR;
+        return CellKind::DEAD_END;
+    };
+
+    m_layout->start = snapToOpen(gridWidth / 2, getGridHeight() / 2);
+    if (at(m_layout->start.first, m_layout->start.second) != CELL_EMPTY) {
+        m_layout->reachable.firstAtDistance = {0, 0};
+        return;
+    }
+
+    std::vector<int>& queue = m_layout->reachable.cells;
+    queue.reserve(cellCount);
+    int startIndex = m_layout->start.second * gridWidth + m_layout->start.first;
+    m_layout->startDistance[startIndex] = 0;
+    queue.push_back(startIndex);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int index = queue[head];
+        int x = index % gridWidth;
+        int y = index / gridWidth;
+        int distance = m_layout->startDistance[index];
+
+        // BFS order is sorted by distance: record where each new distance begins
+        if (distance + 1 > static_cast<int>(m_layout->reachable.firstAtDistance.size())) {
+            m_layout->reachable.firstAtDistance.push_back(static_cast<int>(head));
+        }
+
+        int openNeighbors = 0;
+        for (int i = 0; i < 4; ++i) {
+            int newX = x + directions[i][0];
+            int newY = y + directions[i][1];
+            if (isWallUnchecked(newX, newY)) {
+                continue;
+            }
+            openNeighbors++;
+
+            int newIndex = newY * gridWidth + newX;
+            if (m_layout->startDistance[newIndex] < 0) {
+                m_layout->startDistance[newIndex] = distance + 1;
+                queue.push_back(newIndex);
+            }
+        }
+
+        CellKind kind = classify(x, y, openNeighbors);
+        m_layout->cellKinds[index] = kind;
+
+        DistanceIndex& byKind = m_layout->byKind[static_cast<int>(kind)];
+        while (static_cast<int>(byKind.firstAtDistance.size()) <= distance) {
+            byKind.firstAtDistance.push_back(static_cast<int>(byKind.cells.size()));
+        }
+        byKind.cells.push_back(index);
+    }
+
+    // Close every index with an end entry so distance d spans [first[d], first[d + 1])
+    m_layout->reachable.firstAtDistance.push_back(static_cast<int>(queue.size()));
+    for (auto& index : m_layout->byKind) {
+        while (index.firstAtDistance.size() < m_layout->reachable.firstAtDistance.size()) {
+            index.firstAtDistance.push_back(static_cast<int>(index.cells.size()));
+        }
+    }
+
+    // Cells the start can't reach are still classified, but never sampled
+    for (int y = 0; y < getGridHeight(); ++y) {
+        for (int x = 0; x < gridWidth; ++x) {
+            int index = y * gridWidth + x;
+            if (at(x, y) != CELL_EMPTY || m_layout->startDistance[index] >= 0) {
+                continue;
+            }
+            int openNeighbors = 0;
+            for (int i = 0; i < 4; ++i) {
+                openNeighbors += !isWallUnchecked(x + directions[i][0], y + directions[i][1]);
+            }
+            m_layout->cellKinds[index] = classify(x, y, openNeighbors);
+        }
+    }
+}
+
+void Maze::buildChokepoints() const {
+    Layout& layout = *m_layout;
+    const int gridWidth = getGridWidth();
+    const int cellCount = gridWidth * getGridHeight();
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    layout.cutFlags.assign(cellCount, 0);
+    layout.cellBlock.assign(cellCount, -1);
+    layout.blockHead.clear();
+    layout.blockDepth.clear();
+
+    std::vector<int> order(cellCount, 0);      // Discovery order, from 1 (0 = not visited)
+    std::vector<int> low(cellCount, 0);        // Earliest discovery order reachable through one back edge
+    std::vector<int> path;                     // DFS path from the root (the explicit call stack)
+    std::vector<std::uint8_t> nextDirection;   // Per path entry: next neighbor to try
+    std::vector<int> unassigned;               // Visited cells not yet closed into a component
+    int counter = 0;
+
+    for (int root = 0; root < cellCount; ++root) {
+        if (order[root] != 0 || at(root % gridWidth, root / gridWidth) != CELL_EMPTY) {
+            continue;
+        }
+        order[root] = low[root] = ++counter;
+        path.push_back(root);
+        nextDirection.push_back(0);
+        int rootChildren = 0;
+        int rootBlock = -1;
+
+        while (!path.empty()) {
+            const int cell = path.back();
+            if (nextDirection.back() < 4) {
+                const int direction = nextDirection.back()++;
+                const int newX = cell % gridWidth + directions[direction][0];
+                const int newY = cell / gridWidth + directions[direction][1];
+                if (isWallUnchecked(newX, newY)) {
+                    continue;
+                }
+                const int neighbor = newY * gridWidth + newX;
+                if (order[neighbor] == 0) {
+                    order[neighbor] = low[neighbor] = ++counter;
+                    path.push_back(neighbor);
+                    nextDirection.push_back(0);
+                    unassigned.push_back(neighbor);
+                } else if (path.size() < 2 || neighbor != path[path.size() - 2]) {
+                    low[cell] = std::min(low[cell], order[neighbor]);
+                }
+                continue;
+            }
+
+            // Finished: hand the low-link to the parent
+            path.pop_back();
+            nextDirection.pop_back();
+            if (path.empty()) {
+                break;
+            }
+            const int parent = path.back();
+            low[parent] = std::min(low[parent], low[cell]);
+            if (low[cell] < order[parent]) {
+                continue;
+            }
+
+            // Nothing below cell reaches above parent: the subtree closes a component headed by parent
+            const int block = static_cast<int>(layout.blockHead.size());
+            layout.blockHead.push_back(parent);
+            int member;
+            do {
+                member = unassigned.back();
+                unassigned.pop_back();
+                layout.cellBlock[member] = block;
+            } while (member != cell);
+
+            if (parent == root) {
+                rootChildren++;
+                rootBlock = rootBlock < 0 ? block : rootBlock;
+            } else {
+                layout.cutFlags[parent] |= CUT_ARTICULATION;
+            }
+            if (low[cell] > order[parent]) {
+                // Only the edge itself in the component: a bridge, flagged on its left or upper cell
+                int first = std::min(cell, parent);
+                layout.cutFlags[first] |= std::abs(cell - parent) == 1 ? CUT_BRIDGE_RIGHT : CUT_BRIDGE_DOWN;
+            }
+        }
+
+        if (rootChildren >= 2) {
+            layout.cutFlags[root] |= CUT_ARTICULATION;
+        }
+        if (rootBlock < 0) {
+            // A lone open cell is a component of its own
+            rootBlock = static_cast<int>(layout.blockHead.size());
+            layout.blockHead.push_back(root);
+        }
+        layout.cellBlock[root] = rootBlock;
+    }
+
+    // Components close children first, so walking them backwards sets every parent's depth before its children's
+    layout.blockDepth.assign(layout.blockHead.size(), 0);
+    for (int block = static_cast<int>(layout.blockHead.size()) - 1; block >= 0; --block) {
+        const int head = layout.blockHead[block];
+        if (!(layout.cutFlags[head] & CUT_ARTICULATION)) {
+            continue;  // Hangs from a root that is not an articulation cell: a tree root itself
+        }
+        const int headBlock = layout.cellBlock[head];
+        const bool headIsRoot = layout.blockHead[headBlock] == head;
+        layout.blockDepth[block] = (headIsRoot ? 0 : layout.blockDepth[headBlock] + 1) + 1;
+    }
+}
+
+std::vector<std::pair<int, int>> Maze::getExits() const {
+    ensureAnalysis();
+    const DistanceIndex& exits = m_layout->byKind[static_cast<int>(CellKind::EXIT)];
+    std::vector<std::pair<int, int>> cells;
+    cells.reserve(exits.cells.size());
+    for (int index : exits.cells) {
+        cells.push_back({index % getGridWidth(), index / getGridWidth()});
+    }
+    return cells;
+}
+
+bool Maze::isArticulation(int gridX, int gridY) const {
+    ensureAnalysis();
+    if (!isValidPosition(gridX, gridY)) {
+        return false;
+    }
+    return m_layout->cutFlags[gridY * getGridWidth() + gridX] & CUT_ARTICULATION;
+}
+
+bool Maze::isBridge(int x1, int y1, int x2, int y2) const {
+    ensureAnalysis();
+    if (!isValidPosition(x1, y1) || !isValidPosition(x2, y2) || std::abs(x1 - x2) + std::abs(y1 - y2) != 1) {
+        return false;
+    }
+    int first = std::min(y1 * getGridWidth() + x1, y2 * getGridWidth() + x2);
+    return m_layout->cutFlags[first] & (y1 == y2 ? CUT_BRIDGE_RIGHT : CUT_BRIDGE_DOWN);
+}
+
+int Maze::getBiconnectedComponent(int gridX, int gridY) const {
+    ensureAnalysis();
+    if (!isValidPosition(gridX, gridY)) {
+        return -1;
+    }
+    return m_layout->cellBlock[gridY * getGridWidth() + gridX];
+}
+
+bool Maze::getChokepoints(int fromX, int fromY, int toX, int toY, std::vector<std::pair<int, int>>& cells) const {
+    ensureAnalysis();
+    cells.clear();
+    if (isWall(fromX, fromY) || isWall(toX, toY)) {
+        return false;
+    }
+    const Layout& layout = *m_layout;
+    const int from = fromY * getGridWidth() + fromX;
+    const int to = toY * getGridWidth() + toX;
+
+    // Block-cut tree nodes: a component index (>= 0), or an articulation cell c as -c - 1
+    const int noNode = std::numeric_limits<int>::min();
+    auto isCut = [&](int cell) { return (layout.cutFlags[cell] & CUT_ARTICULATION) != 0; };
+    auto isRoot = [&](int cell) { return layout.blockHead[layout.cellBlock[cell]] == cell; };
+    auto nodeOf = [&](int cell) { return isCut(cell) ? -cell - 1 : layout.cellBlock[cell]; };
+    auto depthOf = [&](int node) {
+        if (node >= 0) return layout.blockDepth[node];
+        int cell = -node - 1;
+        return isRoot(cell) ? 0 : layout.blockDepth[layout.cellBlock[cell]] + 1;
+    };
+    auto parentOf = [&](int node) {
+        if (node >= 0) {
+            int head = layout.blockHead[node];
+            return isCut(head) ? -head - 1 : noNode;
+        }
+        int cell = -node - 1;
+        return isRoot(cell) ? noNode : layout.cellBlock[cell];
+    };
+
+    // Climb both sides to their lowest common node, collecting the articulation cells passed
+    std::vector<int> fromSide;
+    std::vector<int> toSide;
+    auto climb = [&](int& node, std::vector<int>& side) {
+        if (node < 0) side.push_back(-node - 1);
+        node = parentOf(node);
+    };
+    int fromNode = nodeOf(from);
+    int toNode = nodeOf(to);
+    while (depthOf(fromNode) > depthOf(toNode)) climb(fromNode, fromSide);
+    while (depthOf(toNode) > depthOf(fromNode)) climb(toNode, toSide);
+    while (fromNode != toNode) {
+        if (parentOf(fromNode) == noNode) {
+            return false;  // Roots of two different trees: separate open areas
+        }
+        climb(fromNode, fromSide);
+        climb(toNode, toSide);
+    }
+    if (fromNode < 0) {
+        fromSide.push_back(-fromNode - 1);
+    }
+
+    fromSide.insert(fromSide.end(), toSide.rbegin(), toSide.rend());
+    for (int cell : fromSide) {
+        if (cell != from && cell != to) {
+            cells.push_back({cell % getGridWidth(), cell / getGridWidth()});
+        }
+    }
+    return true;
+}
+
+CellKind Maze::getCellKind(int gridX, int gridY) const {
+    ensureAnalysis();
+    if (!isValidPosition(gridX, gridY)) {
+        return CellKind::WALL;
+    }
+    return m_layout->cellKinds[gridY * getGridWidth() + gridX];
+}
+
+int Maze::getStartDistance(int gridX, int gridY) const {
+    ensureAnalysis();
+    if (!isValidPosition(gridX, gridY)) {
+        return -1;
+    }
+    return m_layout->startDistance[gridY * getGridWidth() + gridX];
+}
+
+int Maze::countByDistance(int minDistance, int maxDistance) const {
+    ensureAnalysis();
+    return m_layout->reachable.count(minDistance, maxDistance);
+}
+
+std::pair<int, int> Maze::sampleByDistance(int minDistance, int maxDistance, Random& rng) const {
+    ensureAnalysis();
+    int index = m_layout->reachable.sample(minDistance, maxDistance, rng);
+    return index < 0 ? std::make_pair(-1, -1) : std::make_pair(index % getGridWidth(), index / getGridWidth());
+}
+
+std::pair<int, int> Maze::sampleByDistance(int minDistance, int maxDistance, CellKind kind, Random& rng) const {
+    ensureAnalysis();
+    int index = m_layout->byKind[static_cast<int>(kind)].sample(minDistance, maxDistance, rng);
+    return index < 0 ? std::make_pair(-1, -1) : std::make_pair(index % getGridWidth(), index / getGridWidth());
+}
+
+int Maze::DistanceIndex::count(int minDistance, int maxDistance) const {
+    const int lastDistance = static_cast<int>(firstAtDistance.size()) - 2;
+    minDistance = std::max(minDistance, 0);
+    maxDistance = std::min(maxDistance, lastDistance);
+    if (minDistance > maxDistance) {
+        return 0;
+    }
+    return firstAtDistance[maxDistance + 1] - firstAtDistance[minDistance];
+}
+
+int Maze::DistanceIndex::sample(int minDistance, int maxDistance, Random& rng) const {
+    int available = count(minDistance, maxDistance);
+    if (available == 0) {
+        return -1;
+    }
+    return cells[firstAtDistance[std::max(minDistance, 0)] + rng.uniformInt(0, available - 1)];
+}
+
+void Maze::buildVisibility() {
+    m_layout->rowSpan.assign(getGridWidth() * getGridHeight(), -1);
+    m_layout->colSpan.assign(getGridWidth() * getGridHeight(), -1);
+
+    // Each worker labels every Nth row and column; rows and columns never share output
+    auto labelSpans = [this](int first, int stride) {
+        for (int y = first; y < getGridHeight(); y += stride) {
+            labelRowSpans(y);
+        }
+        for (int x = first; x < getGridWidth(); x += stride) {
+            labelColumnSpans(x);
+        }
+    };
+
+    // Threads only pay off once the grid is large (and asking for the core
+    // count is a file read on some platforms, so small grids skip it)
+    const int minCellsPerThread = 1 << 16;
+    int threadCount = std::max(1, (getGridWidth() * getGridHeight()) / minCellsPerThread);
+    if (threadCount > 1) {
+        threadCount = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), threadCount));
+    }
+
+    if (threadCount == 1) {
+        labelSpans(0, 1);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(labelSpans, i, threadCount);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void Maze::labelRowSpans(int gridY) {
+    std::vector<std::uint8_t> buffer;
+    const std::uint8_t* row = readRow(gridY, buffer);
+    int spanStart = -1;
+    for (int x = 0; x < getGridWidth(); ++x) {
+        int index = gridY * getGridWidth() + x;
+        if (row[x] == CELL_WALL) {
+            spanStart = -1;
+            m_layout->rowSpan.set(index, -1);
+            continue;
         }
+        if (spanStart < 0) spanStart = x;
+        m_layout->rowSpan.set(index, spanStart);
     }
+}
+
+void Maze::labelColumnSpans(int gridX) {
+    int spanStart = -1;
+    for (int y = 0; y < getGridHeight(); ++y) {
+        int index = y * getGridWidth() + gridX;
+        if (isWallUnchecked(gridX, y)) {
+            spanStart = -1;
+            m_layout->colSpan.set(index, -1);
+            continue;
+        }
+        if (spanStart < 0) spanStart = y;
+        m_layout->colSpan.set(index, spanStart);
+    }
+}
+
+std::pair<int, int> Maze::snapToOpen(int gridX, int gridY) const {
+    gridX = std::clamp(gridX, 0, getGridWidth() - 1);
+    gridY = std::clamp(gridY, 0, getGridHeight() - 1);
+
+    int nearest = m_layout->nearestOpen[gridY * getGridWidth() + gridX];
+    if (nearest < 0) {
+        return {gridX, gridY};  // No open cell at all
+    }
+    return {nearest % getGridWidth(), nearest / getGridWidth()};
+}
+
+int Maze::getDistanceToOpen(int gridX, int gridY) const {
+    int clampedX = std::clamp(gridX, 0, getGridWidth() - 1);
+    int clampedY = std::clamp(gridY, 0, getGridHeight() - 1);
+    return m_layout->openDistance[clampedY * getGridWidth() + clampedX] + std::abs(gridX - clampedX) + std::abs(gridY - clampedY);
+}
+
+void Maze::buildDistanceTransform() {
+    m_layout->nearestOpen.assign(getGridWidth() * getGridHeight(), -1);
+    m_layout->openDistance.assign(getGridWidth() * getGridHeight(), -1);
+
+    // Seed with every open cell; the queue never holds more than one entry per cell
+    std::vector<int> queue;
+    queue.reserve(getGridWidth() * getGridHeight());
+    std::vector<std::uint8_t> buffer;
+    for (int y = 0; y < getGridHeight(); ++y) {
+        const std::uint8_t* row = readRow(y, buffer);
+        for (int x = 0; x < getGridWidth(); ++x) {
+            if (row[x] == CELL_EMPTY) {
+                int index = y * getGridWidth() + x;
+                m_layout->nearestOpen.write(index) = index;
+                m_layout->openDistance.write(index) = 0;
+                queue.push_back(index);
+            }
+        }
+    }
+
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int index = queue[head];
+        int x = index % getGridWidth();
+        int y = index / getGridWidth();
+
+        for (int i = 0; i < 4; ++i) {
+            int newX = x + directions[i][0];
+            int newY = y + directions[i][1];
+            if (!isValidPosition(newX, newY)) {
+                continue;
+            }
+
+            int newIndex = newY * getGridWidth() + newX;
+            if (m_layout->openDistance[newIndex] < 0) {
+                m_layout->openDistance.write(newIndex) = m_layout->openDistance[index] + 1;
+                m_layout->nearestOpen.write(newIndex) = m_layout->nearestOpen[index];
+                queue.push_back(newIndex);
+            }
+        }
+    }
+
+    // BFS order is sorted by distance, so the last cell is the farthest
+    m_layout->maxOpenDistance = queue.empty() ? -1 : m_layout->openDistance[queue.back()];
+}
+
+void Maze::updateDistanceTransform(const DirtyRegion& region) {
+    const int gridWidth = getGridWidth();
+    const int gridHeight = getGridHeight();
+
+    // With no open cells before the edit every distance is unknown; start over
+    if (m_layout->maxOpenDistance < 0) {
+        buildDistanceTransform();
+        return;
+    }
+
+    // A cell farther than the old maximum from every edit keeps its nearest open cell
+    const int grow = m_layout->maxOpenDistance;
+    const int left = std::max(0, region.left - grow);
+    const int top = std::max(0, region.top - grow);
+    const int right = std::min(gridWidth - 1, region.right + grow);
+    const int bottom = std::min(gridHeight - 1, region.bottom + grow);
+
+    // The window is recomputed on the side and written back where it changed,
+    // so table pages shared with other copies are only cloned for real changes
+    const int windowWidth = right - left + 1;
+    std::vector<int> distances(static_cast<size_t>(windowWidth) * (bottom - top + 1), -1);
+    std::vector<int> nearest(distances.size(), -1);
+    auto windowIndex = [&](int x, int y) { return (y - top) * windowWidth + (x - left); };
+
+    // Bucket queue: seeds start at different distances, so plain BFS order isn't enough
+    std::vector<std::vector<std::pair<int, int>>> buckets(1);
+    auto push = [&](int x, int y, int distance) {
+        if (distance >= static_cast<int>(buckets.size())) {
+            buckets.resize(distance + 1);
+        }
+        buckets[distance].push_back({x, y});
+    };
+
+    for (int y = top; y <= bottom; ++y) {
+        for (int x = left; x <= right; ++x) {
+            if (at(x, y) == CELL_EMPTY) {
+                distances[windowIndex(x, y)] = 0;
+                nearest[windowIndex(x, y)] = y * gridWidth + x;
+                push(x, y, 0);
+            }
+        }
+    }
+
+    // Any route from outside the window enters through the ring, whose values are unchanged
+    auto seedRing = [&](int x, int y) {
+        if (!isValidPosition(x, y)) {
+            return;
+        }
+        int distance = m_layout->openDistance[y * gridWidth + x];
+        if (distance >= 0) {
+            push(x, y, distance);
+        }
+    };
+    for (int x = left; x <= right; ++x) {
+        seedRing(x, top - 1);
+        seedRing(x, bottom + 1);
+    }
+    for (int y = top; y <= bottom; ++y) {
+        seedRing(left - 1, y);
+        seedRing(right + 1, y);
+    }
+
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    for (size_t distance = 0; distance < buckets.size(); ++distance) {
+        for (size_t i = 0; i < buckets[distance].size(); ++i) {
+            auto [x, y] = buckets[distance][i];
+            bool inWindow = x >= left && x <= right && y >= top && y <= bottom;
+            int source = inWindow ? nearest[windowIndex(x, y)] : m_layout->nearestOpen[y * gridWidth + x];
+
+            for (int d = 0; d < 4; ++d) {
+                int newX = x + directions[d][0];
+                int newY = y + directions[d][1];
+                if (newX < left || newX > right || newY < top || newY > bottom) {
+                    continue;
+                }
+
+                int newIndex = windowIndex(newX, newY);
+                if (distances[newIndex] < 0) {
+                    distances[newIndex] = static_cast<int>(distance) + 1;
+                    nearest[newIndex] = source;
+                    push(newX, newY, static_cast<int>(distance) + 1);
+                }
+            }
+        }
+    }
+
+    for (int y = top; y <= bottom; ++y) {
+        for (int x = left; x <= right; ++x) {
+            m_layout->openDistance.set(y * gridWidth + x, distances[windowIndex(x, y)]);
+            m_layout->nearestOpen.set(y * gridWidth + x, nearest[windowIndex(x, y)]);
+        }
+    }
+
+    // No seeds means the last open cell was closed; the window then covers the whole grid
+    bool seeded = std::any_of(buckets.begin(), buckets.end(), [](const std::vector<std::pair<int, int>>& bucket) { return !bucket.empty(); });
 
-    generateDFS();
+    // Closing walls can only raise the maximum inside the window; keep a safe upper bound
+    m_layout->maxOpenDistance = seeded ? std::max(m_layout->maxOpenDistance, static_cast<int>(buckets.size()) - 1) : -1;
 }
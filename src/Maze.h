@@ -1,25 +1,182 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
-#include <random>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "Config.h"
+#include "GridStorage.h"
+#include "PagedTable.h"
+#include "Random.h"
+
+class ChunkCache;
+class MazeFile;
+class MazeImage;
 
 /**
  * @brief Maze class for generating and rendering the game maze
  *
- * Currently generates random walls for collision testing.
- * Future: Will implement DFS algorithm for proper maze generation.
+ * A grid of cells (grid = logical cells * 2 + 1 per side, with a
+ * sentinel wall border) carved by one of the generators in the registry
+ * (getGenerators: DFS, Kruskal, Prim, Wilson, caves), seeded so the same
+ * seed, size and algorithm give the same maze everywhere. Mazes can also
+ * come from Eller's streaming generator, a MazeFile, an image, or a
+ * window onto the endless ChunkCache world.
+ *
+ * The cells and every table derived from them (line-of-sight spans,
+ * distance transform, start-distance analysis and chokepoints) live in a
+ * Layout shared copy-on-write between Maze copies. The first edit through
+ * a shared copy clones only the cells; the spans and distance transform
+ * sit in shared pages cloned as they are written, and the analysis is
+ * rebuilt when next asked for. Each change bumps the
+ * version; edits repair the tables incrementally and log a dirty
+ * rectangle (getDirtySince) for dependent caches.
  */
 class Maze {
    public:
+    /**
+     * @brief One cell change for applyEdits
+     */
+    struct CellEdit {
+        int x;              ///< X coordinate in grid space
+        int y;              ///< Y coordinate in grid space
+        std::uint8_t value; ///< New cell value (CELL_EMPTY or CELL_WALL)
+    };
+
+    /**
+     * @brief Inclusive rectangle of grid cells touched by edits
+     */
+    struct DirtyRegion {
+        int left = 0;     ///< Smallest X
+        int top = 0;      ///< Smallest Y
+        int right = -1;   ///< Largest X (right < left = empty)
+        int bottom = -1;  ///< Largest Y
+
+        bool isEmpty() const { return right < left || bottom < top; }
+        bool contains(int x, int y) const { return x >= left && x <= right && y >= top && y <= bottom; }
+    };
+
     /**
      * @brief Constructs a new Maze object
      *
-     * Initializes the grid and generates random walls for testing.
+     * @param mazeWidth Width in logical cells (the grid is mazeWidth * 2 + 1 wide)
+     * @param mazeHeight Height in logical cells (the grid is mazeHeight * 2 + 1 high)
+     * @param layout Memory layout of the cell grid (row-major by default)
+     *
+     * Initializes the grid and generates the first maze from a random seed.
+     */
+    explicit Maze(int mazeWidth = DEFAULT_MAZE_WIDTH, int mazeHeight = DEFAULT_MAZE_HEIGHT,
+                  GridLayout layout = GridLayout::ROW_MAJOR);
+
+    /**
+     * @brief Constructs a maze generated from an explicit seed
+     *
+     * @param mazeWidth Width in logical cells
+     * @param mazeHeight Height in logical cells
+     * @param layout Memory layout of the cell grid
+     * @param seed Generation seed; the same seed and size give the same maze on every platform
+     * @param algorithm Carving algorithm, kept for later regenerate calls
+     */
+    Maze(int mazeWidth, int mazeHeight, GridLayout layout, std::uint64_t seed,
+         MazeAlgorithm algorithm = MazeAlgorithm::DFS);
+
+    /**
+     * @brief Constructs a maze from a mapped maze file
+     *
+     * @param file Open maze file
+     * @param layout Memory layout of the cell grid
+     *
+     * Copies the stored cells and rebuilds the derived tables.
+     */
+    explicit Maze(const MazeFile& file, GridLayout layout = GridLayout::ROW_MAJOR);
+
+    /**
+     * @brief Constructs a maze from an imported image layout
+     *
+     * @param image Successfully loaded image
+     * @param layout Memory layout of the cell grid
+     *
+     * Copies the cells as drawn (seeded from their checksum) and rebuilds
+     * the derived tables. Nothing is carved: the start snaps to the open
+     * cell nearest the center, as for any maze.
+     */
+    explicit Maze(const MazeImage& image, GridLayout layout = GridLayout::ROW_MAJOR);
+
+    /**
+     * @brief Makes a copy that shares the cells and derived tables
+     *
+     * @param other Maze to share
+     *
+     * O(1): many matches can hold copies of one seeded maze and read it
+     * concurrently. The first change made through a copy (edit,
+     * regenerate, window load) gives that copy its own layout, leaving the
+     * others untouched.
+     */
+    Maze(const Maze& other);
+    Maze& operator=(const Maze& other);
+    Maze(Maze&&) = default;
+    Maze& operator=(Maze&&) = default;
+
+    /**
+     * @brief Makes an all-wall maze that waits for its first regenerate
+     *
+     * @param mazeWidth Width in logical cells
+     * @param mazeHeight Height in logical cells
+     * @param algorithm Carving algorithm, kept for later regenerate calls
+     * @return Maze with nothing carved and no derived tables
+     *
+     * Costs one grid fill, for holders whose first maze is built elsewhere
+     * (regenerate, loadWindow or assignment). Until then only the size,
+     * the cells and render may be used.
+     */
+    static Maze placeholder(int mazeWidth, int mazeHeight, MazeAlgorithm algorithm = MazeAlgorithm::DFS);
+
+    /**
+     * @brief Gets the number of Maze copies sharing this maze's layout
+     *
+     * @return 1 if the layout is owned exclusively
      */
-    Maze();
+    long getShareCount() const;
+
+    /**
+     * @brief Gets the memory held by the shared layout (cells and derived tables)
+     *
+     * @return Size in bytes, paid once for all copies sharing it
+     */
+    size_t getLayoutMemoryBytes() const;
+
+    /**
+     * @brief Gets the memory held by this copy alone
+     *
+     * @return Size of the handle and its render cache in bytes
+     */
+    size_t getHandleMemoryBytes() const;
+
+    /**
+     * @brief Gets the layout memory no other copy shares
+     *
+     * @return 0 while the layout is shared; after an edit, the cloned cells
+     *         and pages plus any rebuilt analysis, in bytes
+     */
+    size_t getOwnedLayoutMemoryBytes() const;
+
+    /**
+     * @brief Draws a fresh seed from the system entropy source
+     *
+     * @return 64-bit seed
+     */
+    static std::uint64_t randomSeed();
+
+    /**
+     * @brief Gets the seed the current maze was generated from
+     *
+     * @return Generation seed (meaningless in endless mode)
+     */
+    std::uint64_t getSeed() const { return m_layout->seed; }
 
     /**
      * @brief Renders the maze to the given window
@@ -39,6 +196,218 @@ class Maze {
      */
     bool isWall(int gridX, int gridY) const;
 
+    /**
+     * @brief Checks if a grid position is a wall without a bounds check
+     *
+     * @param gridX X coordinate in grid space, -1 to width inclusive
+     * @param gridY Y coordinate in grid space, -1 to height inclusive
+     * @return true if the position is a wall
+     *
+     * The grid has a one-cell sentinel wall border, so any neighbor of an
+     * in-bounds cell can be queried directly.
+     */
+    bool isWallUnchecked(int gridX, int gridY) const { return m_layout->cells.get(gridX, gridY) == CELL_WALL; }
+
+    /**
+     * @brief Gets a row of cells for bulk scans
+     *
+     * @param gridY Row in grid space, -1 to height inclusive
+     * @param buffer Scratch space, used when the layout isn't row-major
+     * @return Pointer to cell (0, gridY); indices -1 to width are readable
+     *
+     * Row-major mazes return the row in place; tiled and Morton mazes copy it
+     * into buffer first. Either way the pointer is valid until the maze or
+     * buffer changes.
+     */
+    const std::uint8_t* readRow(int gridY, std::vector<std::uint8_t>& buffer) const {
+        return m_layout->cells.readRow(gridY, buffer);
+    }
+
+    /**
+     * @brief Gets the memory layout of the cell grid
+     *
+     * @return Layout chosen at construction
+     */
+    GridLayout getLayout() const { return m_layout->cells.getLayout(); }
+
+    /**
+     * @brief Carves a recursive-backtracker maze into a grid without recursion
+     *
+     * @param grid Grid to carve (expected to be all walls)
+     * @param startX Starting X position (odd)
+     * @param startY Starting Y position (odd)
+     * @param rng Random number generator
+     *
+     * Uses an explicit, preallocated stack instead of the call stack, so very
+     * large mazes can't overflow the thread stack. Produces the same maze as
+     * the recursive version for the same RNG state, including the 10% chance
+     * of an extra passage after backtracking.
+     */
+    static void carveDFS(GridStorage& grid, int startX, int startY, Random& rng);
+
+    /**
+     * @brief Carves a maze in independent tiles on several threads
+     *
+     * @param grid Grid to carve (expected to be all walls)
+     * @param seed Seed for the tile mazes and the stitching
+     * @param threadCount Number of worker threads (at least 1)
+     *
+     * Splits the logical cells into GENERATION_TILE_CELLS-sized tiles, carves
+     * each with carveDFS from its own seed, then opens one door per edge of a
+     * random spanning tree over the tiles (union-find), so the result is one
+     * connected maze. The output depends only on the seed and grid size, so
+     * it is the same for every thread count.
+     */
+    static void carveTiled(GridStorage& grid, std::uint64_t seed, int threadCount);
+
+    /**
+     * @brief Carves a maze with randomized Kruskal's algorithm
+     *
+     * @param grid Grid to carve (expected to be all walls)
+     * @param rng Random number generator
+     *
+     * Shuffles every wall between two logical cells and opens it when the
+     * cells are not yet connected (union-find). Needs one int per logical
+     * cell plus one per wall.
+     */
+    static void carveKruskal(GridStorage& grid, Random& rng);
+
+    /**
+     * @brief Carves a maze with randomized Prim's algorithm
+     *
+     * @param grid Grid to carve (expected to be all walls)
+     * @param rng Random number generator
+     *
+     * Grows one tree from the center: repeatedly joins a random frontier
+     * cell to a random neighbor already in the tree. Needs one byte per
+     * logical cell plus the frontier.
+     */
+    static void carvePrim(GridStorage& grid, Random& rng);
+
+    /**
+     * @brief Carves a maze with Wilson's algorithm
+     *
+     * @param grid Grid to carve (expected to be all walls)
+     * @param rng Random number generator
+     *
+     * Adds loop-erased random walks to the tree until every cell is in it,
+     * which samples uniformly from all spanning trees. Needs one byte per
+     * logical cell; the first walks are long, so it is the slowest.
+     */
+    static void carveWilson(GridStorage& grid, Random& rng);
+
+    /**
+     * @brief Grows cave-like open areas with a cellular automaton
+     *
+     * @param grid Grid to carve (expected to be all walls)
+     * @param rng Random number generator
+     *
+     * Starts from CAVE_WALL_PERCENT random walls on a BitGrid and runs
+     * CAVE_SMOOTHING_STEPS generations of the CAVE_BIRTH_MASK /
+     * CAVE_SURVIVE_MASK rule with stepLifeLike, 64 cells per word
+     * operation. The border stays wall and the center is cleared for the
+     * start. The caves are usually disconnected; generate joins them.
+     */
+    static void carveCaves(GridStorage& grid, Random& rng);
+
+    /**
+     * @brief One entry in the generator registry
+     */
+    struct Generator {
+        MazeAlgorithm algorithm;                        ///< Registry key
+        const char* name;                               ///< Command-line name ("dfs", "kruskal", ...)
+        void (*carve)(GridStorage& grid, Random& rng);  ///< Carves open cells into an all-wall grid
+        bool perfect;                                   ///< Carves a perfect maze (else the result is joined up afterwards)
+    };
+
+    /**
+     * @brief Gets every built-in generator
+     *
+     * @return Registry, one entry per MazeAlgorithm in enum order
+     */
+    static const std::vector<Generator>& getGenerators();
+
+    /**
+     * @brief Gets the generator for an algorithm
+     */
+    static const Generator& getGenerator(MazeAlgorithm algorithm);
+
+    /**
+     * @brief Looks up a generator by its command-line name
+     *
+     * @param name Generator name
+     * @return Generator, or nullptr if there is none with that name
+     */
+    static const Generator* findGenerator(const std::string& name);
+
+    /**
+     * @brief Receives one finished grid row from a streaming generator
+     *
+     * Arguments are the grid row index, a pointer to the row's cells
+     * (0=path, 1=wall) and the row width. The pointer is only valid during the call.
+     */
+    using RowConsumer = std::function<void(int gridY, const std::uint8_t* row, int gridWidth)>;
+
+    /**
+     * @brief Generates a maze row by row with Eller's algorithm
+     *
+     * @param mazeWidth Width in logical cells
+     * @param mazeHeight Height in logical cells
+     * @param rng Random number generator
+     * @param emitRow Called once per grid row, top to bottom
+     *
+     * Only O(mazeWidth) state is kept, so arbitrarily tall mazes can be sent
+     * straight to a file or renderer. The result is a perfect (fully
+     * connected) maze with two exits on the border, like generate.
+     */
+    static void streamEller(int mazeWidth, int mazeHeight, Random& rng, const RowConsumer& emitRow);
+
+    /**
+     * @brief Regenerates the maze with Eller's algorithm instead of DFS
+     */
+    void regenerateEller();
+
+    /**
+     * @brief Regenerates the maze with Eller's algorithm from an explicit seed
+     *
+     * @param seed Generation seed
+     */
+    void regenerateEller(std::uint64_t seed);
+
+    /**
+     * @brief Regenerates the maze as random walls, repaired into one connected area
+     *
+     * @param seed Generation seed
+     * @return Number of components before repair
+     */
+    int regenerateRandomWalls(std::uint64_t seed);
+
+    /**
+     * @brief Carves random rectangular open areas into the maze
+     *
+     * Creates larger open spaces and additional connections to reduce dead
+     * ends: about one area per OPEN_AREA_CELLS_PER_AREA grid cells, each
+     * OPEN_AREA_MIN_SIZE to OPEN_AREA_MAX_SIZE cells per side. The border is
+     * left intact. Opening cells can only merge components, so a connected
+     * maze stays connected. Call rebuildDerivedData afterwards (done by
+     * ensureConnectivity when anything was carved).
+     */
+    void addRandomOpenAreas();
+
+    /**
+     * @brief Joins every open area into one connected component
+     *
+     * @return Number of components before repair (1 = already connected, 0 = no open cells)
+     *
+     * Labels open cells with union-find, grows all components through the
+     * interior walls at once (multi-source BFS) and records where fronts
+     * meet, with the number of walls that joining there would carve. Kruskal
+     * over those bridges then carves the cheapest set that connects
+     * everything. Near-linear in the grid size; the border is never carved.
+     * Rebuilds the derived tables.
+     */
+    int ensureConnectivity();
+
     /**
      * @brief Checks if a grid position is valid (within bounds)
      *
@@ -53,48 +422,479 @@ class Maze {
      *
      * @return Width of the grid in cells
      */
-    int getGridWidth() const { return GRID_WIDTH; }
+    int getGridWidth() const { return m_layout->cells.getWidth(); }
 
     /**
      * @brief Gets the grid height
      *
      * @return Height of the grid in cells
      */
-    int getGridHeight() const { return GRID_HEIGHT; }
+    int getGridHeight() const { return m_layout->cells.getHeight(); }
 
     /**
      * @brief Regenerates the maze with a new layout
      *
-     * Creates a completely new maze layout for the next round.
+     * Creates a completely new maze layout for the next round from a random seed.
      */
     void regenerate();
 
+    /**
+     * @brief Regenerates the maze from an explicit seed
+     *
+     * @param seed Generation seed
+     */
+    void regenerate(std::uint64_t seed);
+
+    /**
+     * @brief Regenerates the maze from an explicit seed with another algorithm
+     *
+     * @param seed Generation seed
+     * @param algorithm Carving algorithm, kept for later regenerate calls
+     *
+     * Every algorithm gets the same post-processing (branching paths and exits).
+     */
+    void regenerate(std::uint64_t seed, MazeAlgorithm algorithm);
+
+    /**
+     * @brief Gets the algorithm regenerate uses
+     */
+    MazeAlgorithm getAlgorithm() const { return m_layout->algorithm; }
+
+    /**
+     * @brief Loads a window of the endless world from a chunk cache
+     *
+     * @param chunks Chunk cache supplying the world
+     * @param originX World X of grid cell (0, 0)
+     * @param originY World Y of grid cell (0, 0)
+     *
+     * Copies the world region covered by this maze's grid and rebuilds the
+     * derived tables, so pathfinding, line of sight and rendering all read
+     * the chunked world through the ordinary grid. Switches the maze into
+     * endless mode: open border cells are drawn as paths, not exits.
+     */
+    void loadWindow(ChunkCache& chunks, std::int64_t originX, std::int64_t originY);
+
+    /**
+     * @brief Checks if the maze is a window onto the endless world
+     *
+     * @return true after loadWindow, false after regenerate
+     */
+    bool isEndless() const { return m_layout->endless; }
+
+    /**
+     * @brief Gets the world X of grid cell (0, 0) in endless mode
+     */
+    std::int64_t getOriginX() const { return m_layout->originX; }
+
+    /**
+     * @brief Gets the world Y of grid cell (0, 0) in endless mode
+     */
+    std::int64_t getOriginY() const { return m_layout->originY; }
+
+    /**
+     * @brief Checks if two cells can see each other down a straight corridor
+     *
+     * @param x1 First cell X coordinate
+     * @param y1 First cell Y coordinate
+     * @param x2 Second cell X coordinate
+     * @param y2 Second cell Y coordinate
+     * @return true if both cells share a row or column with no wall between them
+     *
+     * O(1): compares the precomputed corridor spans of the two cells.
+     */
+    bool hasLineOfSight(int x1, int y1, int x2, int y2) const;
+
+    /**
+     * @brief Gets the memory used by the line-of-sight spans
+     *
+     * @return Size of the visibility tables in bytes
+     */
+    size_t getVisibilityMemoryBytes() const;
+
+    /**
+     * @brief Snaps a position to the nearest open cell
+     *
+     * @param gridX X coordinate in grid space
+     * @param gridY Y coordinate in grid space
+     * @return The position itself if open, otherwise the closest open cell (Manhattan)
+     *
+     * O(1) lookup into the distance transform built at regenerate.
+     * Positions outside the grid are clamped to the border first.
+     */
+    std::pair<int, int> snapToOpen(int gridX, int gridY) const;
+
+    /**
+     * @brief Gets the distance from a position to the nearest open cell
+     *
+     * @param gridX X coordinate in grid space
+     * @param gridY Y coordinate in grid space
+     * @return 0 for open cells, otherwise Manhattan steps to the closest open cell
+     */
+    int getDistanceToOpen(int gridX, int gridY) const;
+
+    /**
+     * @brief Gets the player start cell used by the analysis pass
+     *
+     * @return Open cell nearest the grid center
+     */
+    std::pair<int, int> getStart() const {
+        ensureAnalysis();
+        return m_layout->start;
+    }
+
+    /**
+     * @brief Gets the classification of a cell
+     *
+     * @param gridX X coordinate in grid space
+     * @param gridY Y coordinate in grid space
+     * @return Cell kind (WALL outside the grid)
+     */
+    CellKind getCellKind(int gridX, int gridY) const;
+
+    /**
+     * @brief Gets the walking distance from the start cell
+     *
+     * @param gridX X coordinate in grid space
+     * @param gridY Y coordinate in grid space
+     * @return BFS steps from getStart(), or -1 for walls and unreachable cells
+     */
+    int getStartDistance(int gridX, int gridY) const;
+
+    /**
+     * @brief Gets the largest walking distance from the start cell
+     *
+     * @return Steps to the farthest reachable cell
+     */
+    int getMaxStartDistance() const {
+        ensureAnalysis();
+        return static_cast<int>(m_layout->reachable.firstAtDistance.size()) - 2;
+    }
+
+    /**
+     * @brief Counts reachable cells whose distance from the start is in a range
+     *
+     * @param minDistance Smallest distance (inclusive)
+     * @param maxDistance Largest distance (inclusive)
+     * @return Number of cells, O(1)
+     */
+    int countByDistance(int minDistance, int maxDistance) const;
+
+    /**
+     * @brief Gets the open border cells the start can reach
+     *
+     * @return Exit cells, nearest to the start first (none in endless mode)
+     */
+    std::vector<std::pair<int, int>> getExits() const;
+
+    /**
+     * @brief Checks if a cell is an articulation cell
+     *
+     * @param gridX X coordinate in grid space
+     * @param gridY Y coordinate in grid space
+     * @return true if walling the cell off would split its open area
+     */
+    bool isArticulation(int gridX, int gridY) const;
+
+    /**
+     * @brief Checks if the passage between two adjacent open cells is a bridge
+     *
+     * @param x1 First cell X coordinate
+     * @param y1 First cell Y coordinate
+     * @param x2 Second cell X coordinate
+     * @param y2 Second cell Y coordinate
+     * @return true if the cells are adjacent and every route between them uses that passage
+     */
+    bool isBridge(int x1, int y1, int x2, int y2) const;
+
+    /**
+     * @brief Gets the biconnected component of a cell
+     *
+     * @param gridX X coordinate in grid space
+     * @param gridY Y coordinate in grid space
+     * @return Component index, or -1 for walls; an articulation cell belongs
+     *         to several components and reports the one nearest its DFS root
+     */
+    int getBiconnectedComponent(int gridX, int gridY) const;
+
+    /**
+     * @brief Gets the number of biconnected components
+     */
+    int getBiconnectedComponentCount() const {
+        ensureAnalysis();
+        return static_cast<int>(m_layout->blockHead.size());
+    }
+
+    /**
+     * @brief Gets the cells every route between two open cells passes through
+     *
+     * @param fromX Source X coordinate
+     * @param fromY Source Y coordinate
+     * @param toX Destination X coordinate
+     * @param toY Destination Y coordinate
+     * @param cells Receives the chokepoints (articulation cells), ordered
+     *              from source to destination; the endpoints are not included
+     * @return false if either cell is a wall or there is no route
+     *
+     * Walks the block-cut tree built by the analysis pass between the two
+     * cells' components, so the cost is the number of components on the
+     * way, not a search of the grid.
+     */
+    bool getChokepoints(int fromX, int fromY, int toX, int toY, std::vector<std::pair<int, int>>& cells) const;
+
+    /**
+     * @brief Rebuilds every table derived from the cells (visibility, distance transform, analysis)
+     *
+     * Counts as a full change: bumps the version and forgets the edit log,
+     * so getDirtySince reports everything as dirty.
+     */
+    void rebuildDerivedData();
+
+    /**
+     * @brief Changes a single cell and updates the derived tables around it
+     *
+     * @param gridX X coordinate in grid space
+     * @param gridY Y coordinate in grid space
+     * @param value New cell value (CELL_EMPTY or CELL_WALL)
+     * @return true if the cell changed
+     */
+    bool setCell(int gridX, int gridY, std::uint8_t value);
+
+    /**
+     * @brief Changes a batch of cells and updates the derived tables once
+     *
+     * @param edits Cell changes; out-of-bounds entries are ignored
+     * @return Number of cells that actually changed
+     *
+     * Bumps the version and logs the bounding rectangle of the changed
+     * cells. Line-of-sight spans are relabelled only on the touched rows and
+     * columns, and the distance transform only within the rectangle grown by
+     * the largest distance to an open cell. The start-distance analysis is a
+     * single global BFS (one opened wall can shorten every route), so it is
+     * only marked stale and rebuilt by the next analysis query (so an
+     * edited maze must not be queried from several threads at once).
+     */
+    int applyEdits(const std::vector<CellEdit>& edits);
+
+    /**
+     * @brief Gets the version of the cells and derived tables
+     *
+     * @return Value that changes on every edit, regenerate or window load;
+     *         unique across all Maze objects in the process
+     */
+    std::uint64_t getVersion() const { return m_layout->version; }
+
+    /**
+     * @brief Gets the cells changed since an earlier version
+     *
+     * @param version Version a dependent structure was built against
+     * @param region Receives the bounding rectangle of all later edits (empty if none)
+     * @return false if the changes are unknown (full rebuild since, edit log
+     *         overflowed, or the version is from another maze); rebuild everything
+     */
+    bool getDirtySince(std::uint64_t version, DirtyRegion& region) const;
+
+    /**
+     * @brief Picks a random reachable cell whose distance from the start is in a range
+     *
+     * @param minDistance Smallest distance (inclusive)
+     * @param maxDistance Largest distance (inclusive)
+     * @param rng Random number generator
+     * @return Uniformly chosen cell, or (-1, -1) if the range is empty; O(1)
+     */
+    std::pair<int, int> sampleByDistance(int minDistance, int maxDistance, Random& rng) const;
+
+    /**
+     * @brief Picks a random reachable cell of one kind whose distance from the start is in a range
+     *
+     * @param minDistance Smallest distance (inclusive)
+     * @param maxDistance Largest distance (inclusive)
+     * @param kind Cell kind to pick from
+     * @param rng Random number generator
+     * @return Uniformly chosen cell, or (-1, -1) if the range is empty; O(1)
+     */
+    std::pair<int, int> sampleByDistance(int minDistance, int maxDistance, CellKind kind, Random& rng) const;
+
    private:
     /**
-     * @brief Draws wall lines using the new line-based rendering system
+     * @brief Cells sorted by distance from the start, with the offset where each distance begins
+     */
+    struct DistanceIndex {
+        std::vector<int> cells;            ///< Cell indices (y * width + x) in BFS order
+        std::vector<int> firstAtDistance;  ///< firstAtDistance[d]: first entry with distance >= d (one extra end entry)
+
+        /**
+         * @brief Picks a uniform entry with distance in [minDistance, maxDistance]
+         */
+        int sample(int minDistance, int maxDistance, Random& rng) const;
+
+        /**
+         * @brief Counts entries with distance in [minDistance, maxDistance]
+         */
+        int count(int minDistance, int maxDistance) const;
+    };
+
+    /**
+     * @brief Edit batch recorded for getDirtySince
+     */
+    struct EditRecord {
+        std::uint64_t version;  ///< Version after the batch
+        DirtyRegion region;     ///< Cells the batch changed
+    };
+
+    /**
+     * @brief Cells and every table derived from them
      *
-     * @param window Reference to the SFML render window
+     * Copies of a Maze share one Layout read-only. The first change made
+     * through a copy whose Layout is shared gives it its own (see detach),
+     * so a match that never edits its maze only pays for its Maze handle.
+     */
+    struct Layout {
+        Layout(int gridWidth, int gridHeight, GridLayout layout) : cells(gridWidth, gridHeight, layout) {}
+        explicit Layout(const GridStorage& cells) : cells(cells) {}
+
+        GridStorage cells;                 ///< Cell grid with a wall border: 0=path, 1=wall
+        std::uint64_t seed = 0;            ///< Seed of the current maze
+        MazeAlgorithm algorithm = MazeAlgorithm::DFS;  ///< Algorithm regenerate uses
+
+        // Endless mode
+        bool endless = false;              ///< Grid is a window onto a ChunkCache world
+        std::int64_t originX = 0;          ///< World X of grid cell (0, 0)
+        std::int64_t originY = 0;          ///< World Y of grid cell (0, 0)
+
+        // Line of sight
+        PagedTable<int> rowSpan;           ///< Per cell: X where its horizontal corridor starts (-1 = wall)
+        PagedTable<int> colSpan;           ///< Per cell: Y where its vertical corridor starts (-1 = wall)
+
+        // Distance transform
+        PagedTable<int> nearestOpen;       ///< Per cell: index (y * width + x) of the nearest open cell
+        PagedTable<int> openDistance;      ///< Per cell: steps to the nearest open cell
+        int maxOpenDistance = -1;          ///< Upper bound of openDistance (-1 = no open cells)
+
+        // Edits
+        std::uint64_t version = 0;         ///< Current version (see getVersion)
+        std::uint64_t logBase = 0;         ///< Oldest version the edit log fully covers
+        std::deque<EditRecord> editLog;    ///< Recent edit batches, oldest first
+
+        // Analysis (rebuilt lazily after edits, never while shared)
+        bool analysisStale = false;        ///< Cells changed since the last buildAnalysis
+        std::pair<int, int> start;         ///< Player start cell
+        std::vector<CellKind> cellKinds;   ///< Per cell: classification
+        std::vector<int> startDistance;    ///< Per cell: BFS steps from start (-1 = wall/unreachable)
+        DistanceIndex reachable;           ///< All reachable cells by distance
+        DistanceIndex byKind[5];           ///< Reachable cells by distance, per CellKind
+
+        // Chokepoints (part of the analysis)
+        std::vector<std::uint8_t> cutFlags;  ///< Per cell: CUT_* bits
+        std::vector<int> cellBlock;          ///< Per cell: biconnected component of its DFS tree edge (-1 = wall)
+        std::vector<int> blockHead;          ///< Per component: cell it hangs from (an articulation cell or a DFS root)
+        std::vector<int> blockDepth;         ///< Per component: depth in the block-cut tree
+    };
+
+    /**
+     * @brief Wraps a layout without generating anything (see placeholder)
+     */
+    explicit Maze(std::shared_ptr<Layout> layout);
+
+    // Layout::cutFlags bits
+    static constexpr std::uint8_t CUT_ARTICULATION = 1;  ///< Cell is an articulation cell
+    static constexpr std::uint8_t CUT_BRIDGE_RIGHT = 2;  ///< Passage to the cell on the right is a bridge
+    static constexpr std::uint8_t CUT_BRIDGE_DOWN = 4;   ///< Passage to the cell below is a bridge
+
+    /**
+     * @brief Makes sure this copy owns its layout before changing it
      *
-     * Draws thin lines from the center of each wall cell to adjacent walls.
+     * @param keepContents Keep the contents (edits): copies the cells,
+     *                     shares the span and distance pages until they are
+     *                     written, and leaves the analysis to be rebuilt on
+     *                     demand. false starts from an empty layout of the
+     *                     same size (full regeneration)
      */
-    void drawWallLines(sf::RenderWindow& window);
+    void detach(bool keepContents);
+
     /**
-     * @brief Generates a maze using Depth-First Search algorithm
+     * @brief Classifies cells and indexes them by walking distance from the start
      *
-     * Creates a perfect maze starting from the center with guaranteed
-     * paths to all exits. Uses recursive backtracking.
+     * One BFS from the start cell; its visiting order is already sorted by
+     * distance, so the per-distance offsets fall out of the same pass.
      */
-    void generateDFS();
+    void buildAnalysis() const;
 
     /**
-     * @brief Recursive DFS helper function
+     * @brief Labels articulation cells, bridges and biconnected components
      *
-     * @param x Current X position in grid
-     * @param y Current Y position in grid
+     * Tarjan's algorithm over the open cells with an explicit stack (no
+     * recursion, so huge grids can't overflow the thread stack), one DFS
+     * tree per open area. Each component is closed when its head finishes,
+     * which also gives the block-cut tree getChokepoints walks. Linear in
+     * the grid size; run as part of buildAnalysis.
+     */
+    void buildChokepoints() const;
+
+    /**
+     * @brief Rebuilds the analysis if edits have made it stale
+     */
+    void ensureAnalysis() const {
+        if (m_layout->analysisStale) {
+            buildAnalysis();
+            m_layout->analysisStale = false;
+        }
+    }
+
+    /**
+     * @brief Precomputes straight-corridor visibility for every open cell
+     *
+     * Labels each open cell with the start of its horizontal and vertical
+     * corridor run. Rows and columns are independent, so large grids are
+     * split across worker threads.
+     */
+    void buildVisibility();
+
+    /**
+     * @brief Relabels the horizontal corridor spans of one row
+     */
+    void labelRowSpans(int gridY);
+
+    /**
+     * @brief Relabels the vertical corridor spans of one column
+     */
+    void labelColumnSpans(int gridX);
+
+    /**
+     * @brief Maps every wall cell to its nearest open cell
      *
-     * Recursively carves paths from the current position.
+     * Multi-source BFS seeded from all open cells, so it runs in linear time.
      */
-    void dfsRecursive(int x, int y);
+    void buildDistanceTransform();
+
+    /**
+     * @brief Repairs the distance transform after edits inside a rectangle
+     *
+     * @param region Bounding rectangle of the changed cells
+     *
+     * Only cells within m_maxOpenDistance of an edit can change, so a
+     * bucket-queue BFS reruns inside that window, seeded from its open cells
+     * and from the unchanged values on the ring just outside it.
+     */
+    void updateDistanceTransform(const DirtyRegion& region);
+
+    /**
+     * @brief Draws wall lines using the new line-based rendering system
+     *
+     * @param window Reference to the SFML render window
+     *
+     * Draws thin lines from the center of each wall cell to adjacent walls.
+     */
+    void drawWallLines(sf::RenderWindow& window);
+
+    /**
+     * @brief Generates a maze with the layout's algorithm
+     *
+     * Carves with the registered generator (large DFS mazes are carved in
+     * parallel tiles, see carveTiled) and adds exits. Perfect mazes get
+     * branching paths first; other generators are joined into one area
+     * after the exits are open.
+     */
+    void generate();
 
     /**
      * @brief Adds branching paths by removing some walls
@@ -130,27 +930,38 @@ class Maze {
     void createExits();
 
     /**
-     * @brief Adds random open areas to create more interconnected paths
+     * @brief Carves the cheapest walls that join every open area
      *
-     * Creates larger open spaces and additional connections to reduce dead ends.
+     * @return Number of components before joining
+     *
+     * The work behind ensureConnectivity, without detaching or rebuilding
+     * the derived tables, so generate can run it before the caller's rebuild.
      */
-    void addRandomOpenAreas();
+    int joinComponents();
 
     /**
-     * @brief Ensures all areas of the maze are well-connected
+     * @brief Generates random walls for collision testing
      *
-     * Creates corridors between major open areas to prevent isolated sections.
+     * Creates a random pattern of walls (RANDOM_WALL_PERCENT) and paths with
+     * a clear area in the center. The result is usually disconnected; see
+     * regenerateRandomWalls.
      */
-    void ensureConnectivity();
+    void generateRandomWalls();
 
     /**
-     * @brief Generates random walls for collision testing
+     * @brief Mutable access to a cell in the padded grid
      *
-     * Creates a random pattern of walls and paths.
-     * This is temporary - will be replaced with proper maze generation.
+     * @param x X coordinate in grid space
+     * @param y Y coordinate in grid space
+     * @return Reference to the cell value
      */
-    void generateRandomWalls();
+    std::uint8_t& at(int x, int y) { return m_layout->cells.at(x, y); }
+    std::uint8_t at(int x, int y) const { return m_layout->cells.get(x, y); }
+
+    std::shared_ptr<Layout> m_layout;       ///< Cells and derived tables, shared copy-on-write between copies
+    Random m_rng;                           ///< Random number generator, reseeded per maze
 
-    std::vector<std::vector<int>> m_grid;  ///< 2D grid: 0=path, 1=wall
-    std::mt19937 m_rng;                    ///< Random number generator
+    // Rendering (per copy, so matches that never draw pay nothing)
+    std::vector<std::uint8_t> m_wallMasks;  ///< Per cell: wall-line mask (see buildWallMasks)
+    std::uint64_t m_wallMaskVersion = 0;    ///< Version m_wallMasks was built for
 };
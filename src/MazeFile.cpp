@@ -0,0 +1,317 @@
+#include "MazeFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <queue>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Maze.h"
+#include "Random.h"
+
+static_assert(sizeof(MazeFile::Section) == 24, "MazeFile::Section must have a fixed layout");
+static_assert(sizeof(MazeFile::Header) == 48 + 24 * MazeFile::MAX_SECTIONS, "MazeFile::Header must have a fixed layout");
+
+namespace {
+
+const char MAGIC[8] = {'O', 'U', 'B', 'M', 'A', 'Z', 'E', '\0'};
+
+size_t alignUp(size_t value) { return (value + 7) & ~static_cast<size_t>(7); }
+
+}  // namespace
+
+MazeFile::MazeFile()
+    : m_data(nullptr),
+      m_size(0),
+      m_grid(nullptr)
+#ifdef _WIN32
+      ,
+      m_fileHandle(nullptr),
+      m_mappingHandle(nullptr)
+#endif
+{
+}
+
+MazeFile::~MazeFile() {
+    close();
+}
+
+bool MazeFile::write(const std::string& path, const Maze& maze, bool includeStartDistances) {
+    const int gridWidth = maze.getGridWidth();
+    const int gridHeight = maze.getGridHeight();
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.gridWidth = static_cast<std::uint32_t>(gridWidth);
+    header.gridHeight = static_cast<std::uint32_t>(gridHeight);
+    header.seed = maze.getSeed();
+    header.rowBytes = static_cast<std::uint32_t>(alignUp((gridWidth + 7) / 8));
+
+    // Grid section
+    std::vector<std::uint8_t> grid(static_cast<size_t>(header.rowBytes) * gridHeight, 0);
+    std::vector<std::uint8_t> buffer;
+    for (int y = 0; y < gridHeight; ++y) {
+        std::uint8_t* row = &grid[static_cast<size_t>(y) * header.rowBytes];
+        const std::uint8_t* cells = maze.readRow(y, buffer);
+        for (int x = 0; x < gridWidth; ++x) {
+            if (cells[x] == CELL_WALL) {
+                row[x >> 3] |= static_cast<std::uint8_t>(1u << (x & 7));
+            }
+        }
+    }
+    header.checksum = checksum(grid.data(), grid.size());
+
+    size_t offset = alignUp(sizeof(Header));
+    header.sections[header.sectionCount++] = {SECTION_GRID, 0, offset, grid.size()};
+    offset = alignUp(offset + grid.size());
+
+    // Optional start distances: BFS from the cell the player starts on
+    std::vector<std::uint32_t> distances;
+    if (includeStartDistances) {
+        distances.assign(static_cast<size_t>(gridWidth) * gridHeight, UNREACHABLE);
+        auto start = maze.snapToOpen(gridWidth / 2, gridHeight / 2);
+        std::queue<std::pair<int, int>> frontier;
+        distances[start.second * gridWidth + start.first] = 0;
+        frontier.push(start);
+
+        const int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+        while (!frontier.empty()) {
+            auto cell = frontier.front();
+            frontier.pop();
+            std::uint32_t next = distances[cell.second * gridWidth + cell.first] + 1;
+            for (const auto& dir : directions) {
+                int x = cell.first + dir[0];
+                int y = cell.second + dir[1];
+                if (maze.isValidPosition(x, y) && !maze.isWallUnchecked(x, y) &&
+                    distances[y * gridWidth + x] == UNREACHABLE) {
+                    distances[y * gridWidth + x] = next;
+                    frontier.push({x, y});
+                }
+            }
+        }
+
+        size_t bytes = distances.size() * sizeof(std::uint32_t);
+        header.sections[header.sectionCount++] = {SECTION_START_DISTANCE, 0, offset, bytes};
+        offset = alignUp(offset + bytes);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    const char padding[8] = {};
+    auto writePadded = [&](const void* data, size_t bytes) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        out.write(padding, static_cast<std::streamsize>(alignUp(bytes) - bytes));
+    };
+    writePadded(&header, sizeof(header));
+    writePadded(grid.data(), grid.size());
+    if (!distances.empty()) {
+        writePadded(distances.data(), distances.size() * sizeof(std::uint32_t));
+    }
+    return static_cast<bool>(out);
+}
+
+bool MazeFile::writeEller(const std::string& path, int mazeWidth, int mazeHeight, std::uint64_t seed) {
+    const int gridWidth = mazeWidth * 2 + 1;
+    const int gridHeight = mazeHeight * 2 + 1;
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.gridWidth = static_cast<std::uint32_t>(gridWidth);
+    header.gridHeight = static_cast<std::uint32_t>(gridHeight);
+    header.seed = seed;
+    header.rowBytes = static_cast<std::uint32_t>(alignUp((gridWidth + 7) / 8));
+
+    const std::uint64_t gridBytes = static_cast<std::uint64_t>(header.rowBytes) * gridHeight;
+    header.sections[header.sectionCount++] = {SECTION_GRID, 0, alignUp(sizeof(Header)), gridBytes};
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    // The checksum is only known at the end, so the header is written twice
+    const char padding[8] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(padding, static_cast<std::streamsize>(alignUp(sizeof(header)) - sizeof(header)));
+
+    // FNV-1a continued row by row, matching checksum() over the whole section
+    std::uint64_t hash = checksum(nullptr, 0);
+    std::vector<std::uint8_t> packed(header.rowBytes);
+    Random rng(seed);
+    Maze::streamEller(mazeWidth, mazeHeight, rng, [&](int, const std::uint8_t* row, int width) {
+        std::fill(packed.begin(), packed.end(), 0);
+        for (int x = 0; x < width; ++x) {
+            packed[x >> 3] |= static_cast<std::uint8_t>(row[x] << (x & 7));
+        }
+        for (std::uint8_t byte : packed) {
+            hash = (hash ^ byte) * 0x100000001B3ull;
+        }
+        out.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+    });
+
+    header.checksum = hash;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return static_cast<bool>(out);
+}
+
+bool MazeFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    ::close(descriptor);  // The mapping keeps the file alive
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    m_data = static_cast<const std::uint8_t*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    // Validate the header and section table; the cells themselves are not read
+    const Header& fileHeader = header();
+    bool valid = m_size >= sizeof(Header) && std::memcmp(fileHeader.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 fileHeader.version == VERSION && fileHeader.byteOrder == BYTE_ORDER_MARK &&
+                 fileHeader.sectionCount <= MAX_SECTIONS &&
+                 fileHeader.rowBytes >= (static_cast<std::uint64_t>(fileHeader.gridWidth) + 7) / 8;
+
+    for (std::uint32_t i = 0; valid && i < fileHeader.sectionCount; ++i) {
+        const Section& section = fileHeader.sections[i];
+        valid = section.offset % 8 == 0 && section.offset <= m_size && section.size <= m_size - section.offset;
+    }
+
+    const Section* grid = valid ? findSection(SECTION_GRID) : nullptr;
+    valid = grid && grid->size == static_cast<std::uint64_t>(fileHeader.rowBytes) * fileHeader.gridHeight;
+
+    const Section* distances = valid ? findSection(SECTION_START_DISTANCE) : nullptr;
+    if (distances) {
+        valid = distances->size ==
+                static_cast<std::uint64_t>(fileHeader.gridWidth) * fileHeader.gridHeight * sizeof(std::uint32_t);
+    }
+
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    m_grid = m_data + grid->offset;
+    return true;
+}
+
+void MazeFile::close() {
+    if (!m_data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+#else
+    munmap(const_cast<std::uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_grid = nullptr;
+}
+
+void MazeFile::releaseRows(int firstRow, int lastRow) const {
+    if (!m_data || firstRow >= lastRow) {
+        return;
+    }
+    const std::uint8_t* begin = getRowBits(firstRow);
+    const std::uint8_t* end = getRowBits(lastRow);
+#ifdef _WIN32
+    // Unlocking pages that were never locked trims them from the working set
+    VirtualUnlock(const_cast<std::uint8_t*>(begin), static_cast<SIZE_T>(end - begin));
+#else
+    // Only whole pages inside the range; the rows at either end may share a page with others
+    const std::uintptr_t pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::uintptr_t first = (reinterpret_cast<std::uintptr_t>(begin) + pageSize - 1) & ~(pageSize - 1);
+    std::uintptr_t last = reinterpret_cast<std::uintptr_t>(end) & ~(pageSize - 1);
+    if (first < last) {
+        madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+    }
+#endif
+}
+
+bool MazeFile::verifyChecksum() const {
+    const Section* grid = findSection(SECTION_GRID);
+    return grid && checksum(m_data + grid->offset, static_cast<size_t>(grid->size)) == header().checksum;
+}
+
+const std::uint32_t* MazeFile::getStartDistances() const {
+    const Section* section = findSection(SECTION_START_DISTANCE);
+    return section ? reinterpret_cast<const std::uint32_t*>(m_data + section->offset) : nullptr;
+}
+
+std::uint64_t MazeFile::checksum(const std::uint8_t* data, size_t size) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+const MazeFile::Section* MazeFile::findSection(std::uint32_t type) const {
+    if (!m_data) {
+        return nullptr;
+    }
+    for (std::uint32_t i = 0; i < header().sectionCount; ++i) {
+        if (header().sections[i].type == type) {
+            return &header().sections[i];
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Maze;
+
+/**
+ * @brief Versioned binary maze file, read through a read-only memory mapping
+ *
+ * Layout (all integers in host byte order, which the header records):
+ * - Header: magic, version, grid size, seed, checksum and a section table
+ * - Grid section: one bit per cell (1 = wall), rows padded to 8 bytes
+ * - Optional sections, e.g. BFS distances from the start cell
+ *
+ * Every section starts 8-byte aligned, so opening a file only maps it and
+ * checks the header; cells are read straight out of the mapping.
+ */
+class MazeFile {
+   public:
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static constexpr int MAX_SECTIONS = 4;
+
+    enum SectionType : std::uint32_t {
+        SECTION_GRID = 1,            ///< Bit-packed cells
+        SECTION_START_DISTANCE = 2   ///< uint32 BFS steps from the start cell per cell, row-major (UNREACHABLE = none)
+    };
+
+    static constexpr std::uint32_t UNREACHABLE = 0xFFFFFFFFu;
+
+    struct Section {
+        std::uint32_t type;      ///< SectionType (0 = unused slot)
+        std::uint32_t reserved;  ///< Zero
+        std::uint64_t offset;    ///< Byte offset from the start of the file
+        std::uint64_t size;      ///< Size in bytes
+    };
+
+    struct Header {
+        char magic[8];               ///< "OUBMAZE" plus NUL
+        std::uint32_t version;       ///< VERSION
+        std::uint32_t byteOrder;     ///< BYTE_ORDER_MARK as stored by the writer
+        std::uint32_t gridWidth;     ///< Grid width in cells
+        std::uint32_t gridHeight;    ///< Grid height in cells
+        std::uint64_t seed;          ///< Generation seed
+        std::uint64_t checksum;      ///< FNV-1a of the grid section
+        std::uint32_t rowBytes;      ///< Bytes per packed grid row
+        std::uint32_t sectionCount;  ///< Used entries in sections
+        Section sections[MAX_SECTIONS];
+    };
+
+    /**
+     * @brief Creates a closed file object
+     */
+    MazeFile();
+
+    /**
+     * @brief Unmaps the file if open
+     */
+    ~MazeFile();
+
+    MazeFile(const MazeFile&) = delete;
+    MazeFile& operator=(const MazeFile&) = delete;
+
+    /**
+     * @brief Writes a maze to a file
+     *
+     * @param path Output path
+     * @param maze Maze to store
+     * @param includeStartDistances Also store BFS distances from the start cell
+     * @return true on success
+     */
+    static bool write(const std::string& path, const Maze& maze, bool includeStartDistances = false);
+
+    /**
+     * @brief Streams an Eller's-algorithm maze straight to a file
+     *
+     * @param path Output path
+     * @param mazeWidth Width in logical cells
+     * @param mazeHeight Height in logical cells
+     * @param seed Generation seed
+     * @return true on success
+     *
+     * Holds one packed row at a time, so mazes far larger than memory can
+     * be written (for out-of-core tests). The file has no distance section.
+     */
+    static bool writeEller(const std::string& path, int mazeWidth, int mazeHeight, std::uint64_t seed);
+
+    /**
+     * @brief Maps a maze file and validates its header
+     *
+     * @param path File to open
+     * @return true if the file is a readable maze file of this version
+     *
+     * Does not read the cells; call verifyChecksum to check them.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the file
+     */
+    void close();
+
+    /**
+     * @brief Checks if a file is mapped
+     */
+    bool isOpen() const { return m_data != nullptr; }
+
+    /**
+     * @brief Recomputes the grid checksum and compares it with the header
+     *
+     * @return true if the grid section is intact
+     */
+    bool verifyChecksum() const;
+
+    /**
+     * @brief Gets the stored grid width in cells
+     */
+    int getGridWidth() const { return static_cast<int>(header().gridWidth); }
+
+    /**
+     * @brief Gets the stored grid height in cells
+     */
+    int getGridHeight() const { return static_cast<int>(header().gridHeight); }
+
+    /**
+     * @brief Gets the seed the stored maze was generated from
+     */
+    std::uint64_t getSeed() const { return header().seed; }
+
+    /**
+     * @brief Checks if a cell is a wall, straight from the mapping
+     *
+     * @param x X coordinate in grid space (in bounds)
+     * @param y Y coordinate in grid space (in bounds)
+     */
+    bool isWall(int x, int y) const { return (getRowBits(y)[x >> 3] >> (x & 7)) & 1; }
+
+    /**
+     * @brief Gets a packed grid row (bit x % 8 of byte x / 8 is cell x)
+     *
+     * @param y Row in grid space
+     */
+    const std::uint8_t* getRowBits(int y) const { return m_grid + static_cast<size_t>(y) * header().rowBytes; }
+
+    /**
+     * @brief Gets the bytes per packed grid row (a multiple of 8)
+     */
+    size_t getRowBytes() const { return header().rowBytes; }
+
+    /**
+     * @brief Drops mapped grid rows from the process's resident memory
+     *
+     * @param firstRow First row to release
+     * @param lastRow One past the last row to release
+     *
+     * The mapping stays valid; released rows are read back from the file
+     * if touched again. Lets a sweep over a maze larger than RAM keep its
+     * resident set bounded.
+     */
+    void releaseRows(int firstRow, int lastRow) const;
+
+    /**
+     * @brief Gets the stored BFS distances from the start cell
+     *
+     * @return Row-major distances, or nullptr if the file has no such section
+     */
+    const std::uint32_t* getStartDistances() const;
+
+    /**
+     * @brief FNV-1a 64-bit hash
+     *
+     * @param data Bytes to hash
+     * @param size Number of bytes
+     */
+    static std::uint64_t checksum(const std::uint8_t* data, size_t size);
+
+   private:
+    const Header& header() const { return *reinterpret_cast<const Header*>(m_data); }
+
+    /**
+     * @brief Finds a section of the given type
+     *
+     * @return The section, or nullptr
+     */
+    const Section* findSection(std::uint32_t type) const;
+
+    const std::uint8_t* m_data;  ///< Start of the mapping (nullptr when closed)
+    size_t m_size;               ///< Mapping size in bytes
+    const std::uint8_t* m_grid;  ///< Start of the grid section
+#ifdef _WIN32
+    void* m_fileHandle;          ///< Windows file handle
+    void* m_mappingHandle;       ///< Windows file mapping handle
+#endif
+};
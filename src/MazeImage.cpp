@@ -0,0 +1,182 @@
+#include "MazeImage.h"
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "Config.h"
+#include "MazeFile.h"
+
+namespace {
+
+/**
+ * @brief Marks the pixels of one row that count as wall
+ *
+ * @param rgba First pixel of the row
+ * @param width Pixels in the row
+ * @param dark Receives 1 per wall pixel, 0 otherwise
+ *
+ * Integer luma (77 R + 150 G + 29 B) / 256, compared without the divide.
+ * No branches and no cross-iteration state, so the loop is vectorized.
+ */
+void thresholdRow(const std::uint8_t* rgba, int width, std::uint8_t* dark) {
+    const unsigned limit = static_cast<unsigned>(IMAGE_WALL_LUMINANCE) * 256;
+    const unsigned minAlpha = static_cast<unsigned>(IMAGE_MIN_ALPHA);
+    for (int x = 0; x < width; ++x) {
+        const std::uint8_t* pixel = rgba + 4 * x;
+        unsigned luma = 77u * pixel[0] + 150u * pixel[1] + 29u * pixel[2];
+        dark[x] = static_cast<std::uint8_t>((luma < limit) & (pixel[3] >= minAlpha));
+    }
+}
+
+/**
+ * @brief Packs one byte per cell (0 or 1) into a BitGrid row
+ */
+void packRow(const std::uint8_t* cells, int width, std::uint64_t* words) {
+    for (int word = 0; word * BitGrid::WORD_BITS < width; ++word) {
+        const int first = word * BitGrid::WORD_BITS;
+        const int count = std::min(BitGrid::WORD_BITS, width - first);
+        std::uint64_t bits = 0;
+        for (int i = 0; i < count; ++i) {
+            bits |= static_cast<std::uint64_t>(cells[first + i]) << i;
+        }
+        words[word] = bits;
+    }
+}
+
+}  // namespace
+
+const char* MazeImage::describe(Status status) {
+    switch (status) {
+        case Status::OK:
+            return "ok";
+        case Status::DECODE_FAILED:
+            return "could not decode the image";
+        case Status::BAD_SIZE:
+            return "image is smaller than 3x3 cells";
+        case Status::NO_EXITS:
+            return "border has no exit";
+        case Status::BLOCKED_EXIT:
+            return "an exit has no open cell behind it";
+    }
+    return "unknown";
+}
+
+MazeImage::Status MazeImage::load(const std::string& path, int cellPixels) {
+    sf::Image image;
+    if (!image.loadFromFile(path) || !image.getPixelsPtr()) {
+        return Status::DECODE_FAILED;
+    }
+    return loadPixels(image.getPixelsPtr(), static_cast<int>(image.getSize().x), static_cast<int>(image.getSize().y),
+                      cellPixels);
+}
+
+MazeImage::Status MazeImage::loadPixels(const std::uint8_t* rgba, int width, int height, int cellPixels) {
+    if (cellPixels < 1) {
+        return Status::BAD_SIZE;
+    }
+    const int gridWidth = width / cellPixels;
+    const int gridHeight = height / cellPixels;
+    if (gridWidth < 3 || gridHeight < 3) {
+        return Status::BAD_SIZE;
+    }
+
+    BitGrid cells(gridWidth, gridHeight);
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    const int usedWidth = gridWidth * cellPixels;
+
+    // A wall needs more than half of its block's pixels dark
+    const std::uint32_t majority = static_cast<std::uint32_t>(cellPixels) * cellPixels / 2;
+
+    auto importRows = [&](int firstRow, int lastRow) {
+        std::vector<std::uint8_t> dark(usedWidth);
+        std::vector<std::uint32_t> counts(cellPixels > 1 ? gridWidth : 0);
+        std::vector<std::uint8_t> walls(cellPixels > 1 ? gridWidth : 0);
+
+        for (int y = firstRow; y < lastRow; ++y) {
+            const std::uint8_t* pixels = rgba + static_cast<size_t>(y) * cellPixels * rowBytes;
+            if (cellPixels == 1) {
+                thresholdRow(pixels, usedWidth, dark.data());
+                packRow(dark.data(), gridWidth, cells.row(y));
+                continue;
+            }
+
+            std::fill(counts.begin(), counts.end(), 0);
+            for (int row = 0; row < cellPixels; ++row) {
+                thresholdRow(pixels + row * rowBytes, usedWidth, dark.data());
+                const std::uint8_t* block = dark.data();
+                for (int x = 0; x < gridWidth; ++x, block += cellPixels) {
+                    std::uint32_t sum = 0;
+                    for (int i = 0; i < cellPixels; ++i) {
+                        sum += block[i];
+                    }
+                    counts[x] += sum;
+                }
+            }
+            for (int x = 0; x < gridWidth; ++x) {
+                walls[x] = counts[x] > majority;
+            }
+            packRow(walls.data(), gridWidth, cells.row(y));
+        }
+    };
+
+    // Each thread owns whole rows of cells, and so whole BitGrid words
+    const long long pixelCount = static_cast<long long>(usedWidth) * gridHeight * cellPixels;
+    int threadCount = static_cast<int>(std::min<long long>(gridHeight, pixelCount / IMAGE_PIXELS_PER_THREAD));
+    threadCount = std::max(1, std::min(threadCount, static_cast<int>(std::thread::hardware_concurrency())));
+    if (threadCount == 1) {
+        importRows(0, gridHeight);
+    } else {
+        std::vector<std::thread> workers;
+        for (int i = 0; i < threadCount; ++i) {
+            workers.emplace_back(importRows, gridHeight * i / threadCount, gridHeight * (i + 1) / threadCount);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    int exitCount = 0;
+    Status status = validate(cells, exitCount);
+    if (status != Status::OK) {
+        return status;
+    }
+
+    m_cells = std::move(cells);
+    m_exitCount = exitCount;
+    m_checksum = MazeFile::checksum(reinterpret_cast<const std::uint8_t*>(m_cells.row(0)),
+                                    static_cast<size_t>(m_cells.getWordsPerRow()) * gridHeight * sizeof(std::uint64_t));
+    return Status::OK;
+}
+
+MazeImage::Status MazeImage::validate(const BitGrid& cells, int& exitCount) {
+    const int gridWidth = cells.getWidth();
+    const int gridHeight = cells.getHeight();
+    exitCount = 0;
+
+    // Walk the border; every open cell must lead to an open cell inside it
+    auto checkExit = [&](int x, int y, int insideX, int insideY) {
+        if (cells.get(x, y)) {
+            return true;
+        }
+        exitCount++;
+        bool corner = (x == 0 || x == gridWidth - 1) && (y == 0 || y == gridHeight - 1);
+        return !corner && !cells.get(insideX, insideY);
+    };
+
+    bool blocked = false;
+    for (int x = 0; x < gridWidth; ++x) {
+        blocked |= !checkExit(x, 0, x, 1);
+        blocked |= !checkExit(x, gridHeight - 1, x, gridHeight - 2);
+    }
+    for (int y = 1; y < gridHeight - 1; ++y) {
+        blocked |= !checkExit(0, y, 1, y);
+        blocked |= !checkExit(gridWidth - 1, y, gridWidth - 2, y);
+    }
+
+    if (blocked) {
+        return Status::BLOCKED_EXIT;
+    }
+    return exitCount > 0 ? Status::OK : Status::NO_EXITS;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "BitGrid.h"
+
+/**
+ * @brief Hand-drawn maze layout imported from an image
+ *
+ * Every cellPixels x cellPixels block of the image becomes one grid cell:
+ * a wall if most of its pixels are opaque and darker than
+ * IMAGE_WALL_LUMINANCE, open otherwise. The cells land straight in a
+ * BitGrid (set = wall), ready for Maze(const MazeImage&).
+ *
+ * Open cells on the border are exits. A layout is rejected if it has no
+ * exit, or an exit that leads nowhere (no open cell next to it inside the
+ * border).
+ */
+class MazeImage {
+   public:
+    enum class Status {
+        OK,
+        DECODE_FAILED,  ///< The file could not be read or decoded
+        BAD_SIZE,       ///< Fewer than 3x3 cells, or a cell size below 1 pixel
+        NO_EXITS,       ///< The border is closed
+        BLOCKED_EXIT    ///< An open border cell has no open neighbor inside the border
+    };
+
+    /**
+     * @brief Gets a readable description of a status
+     */
+    static const char* describe(Status status);
+
+    /**
+     * @brief Decodes an image file (PNG, BMP, ...) and imports it
+     *
+     * @param path Image file
+     * @param cellPixels Side of one grid cell in pixels
+     * @return Status::OK on success; otherwise the previous layout is kept
+     */
+    Status load(const std::string& path, int cellPixels = 1);
+
+    /**
+     * @brief Imports decoded RGBA pixels
+     *
+     * @param rgba Row-major pixels, 4 bytes each
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param cellPixels Side of one grid cell in pixels; pixels past the
+     *                   last whole cell are ignored
+     * @return Status::OK on success; otherwise the previous layout is kept
+     *
+     * Rows of cells are split across cores. Each pixel row is thresholded
+     * into a byte per pixel by a plain loop the compiler vectorizes, then
+     * summed per cell (or packed straight into words for 1-pixel cells).
+     */
+    Status loadPixels(const std::uint8_t* rgba, int width, int height, int cellPixels = 1);
+
+    int getGridWidth() const { return m_cells.getWidth(); }
+    int getGridHeight() const { return m_cells.getHeight(); }
+
+    /**
+     * @brief Checks if a cell is a wall
+     *
+     * @param x X coordinate in grid space (in bounds)
+     * @param y Y coordinate in grid space (in bounds)
+     */
+    bool isWall(int x, int y) const { return m_cells.get(x, y); }
+
+    /**
+     * @brief Gets the imported cells (set = wall)
+     */
+    const BitGrid& getCells() const { return m_cells; }
+
+    /**
+     * @brief Gets the number of open border cells
+     */
+    int getExitCount() const { return m_exitCount; }
+
+    /**
+     * @brief Gets a hash of the cells, usable as the maze seed
+     */
+    std::uint64_t getChecksum() const { return m_checksum; }
+
+   private:
+    /**
+     * @brief Checks the border of a freshly imported grid
+     *
+     * @param cells Imported cells
+     * @param exitCount Receives the number of open border cells
+     */
+    static Status validate(const BitGrid& cells, int& exitCount);
+
+    BitGrid m_cells;               ///< One bit per grid cell, set = wall
+    int m_exitCount = 0;           ///< Open border cells
+    std::uint64_t m_checksum = 0;  ///< FNV-1a of the cell words
+};
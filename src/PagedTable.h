@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Fixed-size table stored in reference-counted pages
+ *
+ * Copying a table copies one pointer per page and shares the pages. The
+ * first write to a shared page clones that page alone, so two copies of a
+ * large table that each change a few entries only pay for the pages they
+ * touched.
+ *
+ * Writes to distinct entries may run on several threads as long as no page
+ * is shared while they do (a freshly assigned table owns all its pages).
+ */
+template <class T>
+class PagedTable {
+   public:
+    static constexpr int PAGE_BITS = 8;  ///< log2 of the entries per page
+    static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+
+    /**
+     * @brief Replaces the contents with size copies of value, in unshared pages
+     */
+    void assign(size_t size, const T& value) {
+        m_size = size;
+        m_pages.clear();
+        m_pages.reserve((size + PAGE_SIZE - 1) / PAGE_SIZE);
+        for (size_t first = 0; first < size; first += PAGE_SIZE) {
+            auto page = std::make_shared<Page>();
+            page->values.fill(value);
+            m_pages.push_back(std::move(page));
+        }
+    }
+
+    /**
+     * @brief Reads an entry
+     */
+    const T& operator[](size_t index) const { return m_pages[index >> PAGE_BITS]->values[index & (PAGE_SIZE - 1)]; }
+
+    /**
+     * @brief Gets a writable entry, cloning its page first if it is shared
+     */
+    T& write(size_t index) {
+        std::shared_ptr<Page>& page = m_pages[index >> PAGE_BITS];
+        if (page.use_count() > 1) {
+            page = std::make_shared<Page>(*page);
+        }
+        return page->values[index & (PAGE_SIZE - 1)];
+    }
+
+    /**
+     * @brief Writes an entry only if it changes, so unchanged pages stay shared
+     */
+    void set(size_t index, const T& value) {
+        if ((*this)[index] != value) {
+            write(index) = value;
+        }
+    }
+
+    /**
+     * @brief Gets the number of entries
+     */
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief Gets the memory held by the page pointers and every page
+     *
+     * @param ownedOnly Count only pages no other table shares
+     */
+    size_t getMemoryBytes(bool ownedOnly = false) const {
+        size_t bytes = m_pages.capacity() * sizeof(std::shared_ptr<Page>);
+        for (const auto& page : m_pages) {
+            if (!ownedOnly || page.use_count() == 1) {
+                bytes += sizeof(Page);
+            }
+        }
+        return bytes;
+    }
+
+   private:
+    struct Page {
+        std::array<T, PAGE_SIZE> values;
+    };
+
+    std::vector<std::shared_ptr<Page>> m_pages;  ///< Pages in order, the last one padded
+    size_t m_size = 0;                           ///< Entries in use
+};
@@ -1,144 +1,253 @@
 #include "Pathfinder.h"
 
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
-#include "Maze.h"
-
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
 
-std::vector<std::pair<int, int>> Pathfinder::findPath(int startX, int startY, int goalX, int goalY, const Maze& maze) {
-    // Check if start and goal are valid
-    if (!maze.isValidPosition(startX, startY) || !maze.isValidPosition(goalX, goalY)) {
-        return {};  // Invalid positions
+#include "Maze.h"
+#include "MazeFile.h"
+
+namespace {
+
+/**
+ * @brief Frontier entry crossing into another tile of an external distance field
+ */
+struct Seed {
+    std::uint64_t tile;      ///< Target tile index (tiles row-major)
+    std::uint32_t cell;      ///< Cell inside the tile (row-major, tile-wide rows)
+    std::uint32_t distance;  ///< Steps from the target
+};
+
+/**
+ * @brief Appends seeds to a frontier file through a fixed buffer
+ */
+class SpillWriter {
+   public:
+    SpillWriter(const std::string& path, std::uint64_t& bytesWritten)
+        : m_out(path, std::ios::binary | std::ios::trunc), m_bytesWritten(bytesWritten) {
+        m_buffer.reserve(EXTERNAL_SPILL_SEEDS);
     }
 
-    // Check if start and goal are the same
-    if (startX == goalX && startY == goalY) {
-        return {{startX, startY}};
+    void push(const Seed& seed) {
+        m_buffer.push_back(seed);
+        if (m_buffer.size() == static_cast<size_t>(EXTERNAL_SPILL_SEEDS)) {
+            flush();
+        }
     }
 
-    // Priority queue for open set (min-heap based on f-score)
-    std::priority_queue<Node*, std::vector<Node*>, NodeComparator> openSet;
-
-    // Hash set for closed set (visited nodes)
-    std::unordered_set<int> closedSet;
-
-    // Hash map for open set lookup (for updating existing nodes)
-    std::unordered_map<int, Node*> openMap;
-
-    Node* startNode = new Node(startX, startY, 0, manhattanDistance(startX, startY, goalX, goalY));
-    openSet.push(startNode);
-    openMap[startX * GRID_WIDTH + startY] = startNode;
+    /**
+     * @brief Writes what is buffered and closes the file
+     *
+     * @return true if every write succeeded
+     */
+    bool finish() {
+        flush();
+        m_out.close();
+        return !m_out.fail();
+    }
 
-    while (!openSet.empty()) {
-        // Get node with lowest f-score
-        Node* current = openSet.top();
-        openSet.pop();
+    bool isEmpty() const { return m_count == 0 && m_buffer.empty(); }
 
-        // Move from open to closed set
-        int currentKey = current->x * GRID_WIDTH + current->y;
-        openMap.erase(currentKey);
-        closedSet.insert(currentKey);
+   private:
+    void flush() {
+        size_t bytes = m_buffer.size() * sizeof(Seed);
+        m_out.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(bytes));
+        m_bytesWritten += bytes;
+        m_count += m_buffer.size();
+        m_buffer.clear();
+    }
 
-        // Check if we reached the goal
-        if (current->x == goalX && current->y == goalY) {
-            std::vector<std::pair<int, int>> path = reconstructPath(current);
+    std::ofstream m_out;
+    std::uint64_t& m_bytesWritten;
+    std::vector<Seed> m_buffer;
+    std::uint64_t m_count = 0;
+};
+
+/**
+ * @brief Reads a frontier file from its end back to its start, a buffer at a time
+ */
+class SpillReader {
+   public:
+    SpillReader(const std::string& path, std::uint64_t& bytesRead)
+        : m_in(path, std::ios::binary | std::ios::ate), m_bytesRead(bytesRead) {
+        m_remaining = m_in ? static_cast<std::uint64_t>(m_in.tellg()) / sizeof(Seed) : 0;
+        refill();
+    }
 
-            // Clean up memory
-            for (auto& pair : openMap) {
-                delete pair.second;
-            }
-            // Note: current and other closed nodes will be cleaned up by reconstructPath
+    bool hasNext() const { return m_index > 0; }
+    const Seed& peek() const { return m_buffer[m_index - 1]; }
 
-            return path;
+    void pop() {
+        if (--m_index == 0) {
+            refill();
         }
+    }
 
-        // Explore neighbors
-        std::vector<std::pair<int, int>> neighbors = getNeighbors(*current, maze);
+   private:
+    void refill() {
+        size_t count = static_cast<size_t>(std::min<std::uint64_t>(m_remaining, EXTERNAL_SPILL_SEEDS));
+        if (count == 0) {
+            return;
+        }
+        m_remaining -= count;
+        m_buffer.resize(count);
+        m_in.seekg(static_cast<std::streamoff>(m_remaining * sizeof(Seed)));
+        m_in.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(count * sizeof(Seed)));
+        m_bytesRead += count * sizeof(Seed);
+        m_index = m_in ? count : 0;
+    }
 
-        for (const auto& neighbor : neighbors) {
-            int neighborX = neighbor.first;
-            int neighborY = neighbor.second;
-            int neighborKey = neighborX * GRID_WIDTH + neighborY;
+    std::ifstream m_in;
+    std::uint64_t& m_bytesRead;
+    std::vector<Seed> m_buffer;
+    std::uint64_t m_remaining = 0;  ///< Seeds before the buffer, not read yet
+    size_t m_index = 0;             ///< Unread seeds in the buffer (read from the back)
+};
+
+/**
+ * @brief Gets the peak resident set size of the process in bytes
+ */
+std::uint64_t peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss);  // Bytes
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;  // Kilobytes
+#endif
+#endif
+}
 
-            // Skip if already in closed set
-            if (closedSet.find(neighborKey) != closedSet.end()) {
-                continue;
-            }
+}  // namespace
 
-            int tentativeG = current->g + 1;  // Each step costs 1
-
-            // Check if this path to neighbor is better
-            auto openIt = openMap.find(neighborKey);
-            if (openIt != openMap.end()) {
-                // Neighbor already in open set
-                Node* existingNode = openIt->second;
-                if (tentativeG < existingNode->g) {
-                    // better path to this neighbor
-                    existingNode->g = tentativeG;
-                    existingNode->f = existingNode->g + existingNode->h;
-                    existingNode->parent = current;
-                }
-            } else {
-                // New node, add to open set
-                Node* neighborNode = new Node(neighborX, neighborY, tentativeG,
-                                              manhattanDistance(neighborX, neighborY, goalX, goalY), current);
-                openSet.push(neighborNode);
-                openMap[neighborKey] = neighborNode;
-            }
+template <class Kernel>
+auto Pathfinder::withGrid(const Maze& maze, Kernel&& kernel) {
+    if (m_gridVersion != maze.getVersion()) {
+        m_useFixedGrid = DefaultGrid::fits(maze);
+        if (m_useFixedGrid) {
+            m_fixedGrid.load(maze);
+        } else {
+            m_dynamicGrid.load(maze);
         }
+        m_gridVersion = maze.getVersion();
     }
+    return m_useFixedGrid ? kernel(m_fixedGrid) : kernel(m_dynamicGrid);
+}
 
-    // Clean up remaining memory
-    for (auto& pair : openMap) {
-        delete pair.second;
+std::vector<std::pair<int, int>> Pathfinder::findPath(int startX, int startY, int goalX, int goalY, const Maze& maze) {
+    // Check if start and goal are valid
+    if (!maze.isValidPosition(startX, startY) || !maze.isValidPosition(goalX, goalY)) {
+        return {};  // Invalid positions
     }
 
-    return {};
+    return withGrid(maze, [&](const auto& grid) {
+        return findBestFirstPath<SearchOrder::A_STAR>(grid, startX, startY, goalX, goalY, m_bestFirst);
+    });
 }
 
 int Pathfinder::manhattanDistance(int x1, int y1, int x2, int y2) {
     return std::abs(x1 - x2) + std::abs(y1 - y2);
 }
 
-std::vector<std::pair<int, int>> Pathfinder::getNeighbors(const Node& node, const Maze& maze) {
-    std::vector<std::pair<int, int>> neighbors;
+void Pathfinder::prepareCoarseField(int playerX, int playerY, const Maze& maze) {
+    int sectorX = playerX / COARSE_FIELD_SECTOR_SIZE;
+    int sectorY = playerY / COARSE_FIELD_SECTOR_SIZE;
+
+    // Only rebuild when the player changes sector (or the maze was resized or edited)
+    bool sizeChanged = m_coarseField.size() != static_cast<size_t>((maze.getGridWidth() + 2) * (maze.getGridHeight() + 2));
+    bool mazeChanged = maze.getVersion() != m_coarseVersion;
+    if (sizeChanged || mazeChanged || sectorX != m_coarseSectorX || sectorY != m_coarseSectorY) {
+        // A ghosted player inside a wall is chased to the nearest open cell
+        auto target = maze.snapToOpen(playerX, playerY);
+        buildCoarseField(target.first, target.second, maze);
+        m_coarseSectorX = sectorX;
+        m_coarseSectorY = sectorY;
+        m_coarseVersion = maze.getVersion();
+    }
+}
+
+std::pair<int, int> Pathfinder::coarseStep(int x, int y, int playerX, int playerY, const Maze& maze) {
+    prepareCoarseField(playerX, playerY, maze);
+
+    if (!maze.isValidPosition(x, y)) {
+        return {x, y};
+    }
+
+    // The field covers the wall border too (always -1), so neighbors need no bounds check
+    int bestDist = m_coarseField[(y + 1) * m_coarseStride + x + 1];
+    std::pair<int, int> best = {x, y};
 
     int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
 
     for (int i = 0; i < 4; ++i) {
-        int newX = node.x + directions[i][0];
-        int newY = node.y + directions[i][1];
+        int newX = x + directions[i][0];
+        int newY = y + directions[i][1];
 
-        // Check if position is valid and not a wall
-        if (maze.isValidPosition(newX, newY) && !maze.isWall(newX, newY)) {
-            neighbors.push_back({newX, newY});
+        int dist = m_coarseField[(newY + 1) * m_coarseStride + newX + 1];
+        if (dist >= 0 && (bestDist < 0 || dist < bestDist)) {
+            bestDist = dist;
+            best = {newX, newY};
         }
     }
 
-    return neighbors;
+    return best;
 }
 
-std::vector<std::pair<int, int>> Pathfinder::reconstructPath(Node* goalNode) {
-    std::vector<std::pair<int, int>> path;
-    Node* current = goalNode;
-
-    while (current != nullptr) {
-        path.push_back({current->x, current->y});
-        current = current->parent;
-    }
+void Pathfinder::resetCoarseField() {
+    m_coarseField.clear();
+    m_coarseSectorX = -1;
+    m_coarseSectorY = -1;
+}
 
-    // Reverse to get path from start to goal
-    std::reverse(path.begin(), path.end());
+void Pathfinder::adoptCoarseField(Pathfinder& prepared) {
+    m_coarseField.swap(prepared.m_coarseField);
+    m_coarseStride = prepared.m_coarseStride;
+    m_coarseSectorX = prepared.m_coarseSectorX;
+    m_coarseSectorY = prepared.m_coarseSectorY;
+    m_coarseVersion = prepared.m_coarseVersion;
+    m_coarseFieldBuilds += prepared.m_coarseFieldBuilds;
+
+    // The snapshot the field was built from matches the same maze version
+    std::swap(m_fixedGrid, prepared.m_fixedGrid);
+    std::swap(m_dynamicGrid, prepared.m_dynamicGrid);
+    m_useFixedGrid = prepared.m_useFixedGrid;
+    m_gridVersion = prepared.m_gridVersion;
+
+    prepared = Pathfinder();
+}
 
-    // Clean up memory
-    current = goalNode;
-    while (current != nullptr) {
-        Node* parent = current->parent;
-        delete current;
-        current = parent;
-    }
+void Pathfinder::buildCoarseField(int targetX, int targetY, const Maze& maze) {
+    m_coarseFieldBuilds++;
 
-    return path;
+    withGrid(maze, [&](const auto& grid) {
+        m_coarseStride = grid.stride();
+        if (!maze.isValidPosition(targetX, targetY) || maze.isWall(targetX, targetY)) {
+            m_coarseField.assign(grid.size(), -1);
+            return;
+        }
+        fillDistanceField(grid, grid.index(targetX, targetY), m_coarseField, m_searchQueue);
+    });
 }
 
 std::vector<std::pair<int, int>> Pathfinder::findPathDijkstra(int startX, int startY, int goalX, int goalY, const Maze& maze) {
@@ -147,87 +256,9 @@ std::vector<std::pair<int, int>> Pathfinder::findPathDijkstra(int startX, int st
         return {};  // Invalid positions
     }
 
-    // Check if start and goal are the same
-    if (startX == goalX && startY == goalY) {
-        return {{startX, startY}};
-    }
-
-    // Priority queue for open set (min-heap based on g-score only)
-    std::priority_queue<Node*, std::vector<Node*>, NodeComparator> openSet;
-
-    // Hash set for closed set (visited nodes)
-    std::unordered_set<int> closedSet;
-
-    // Hash map for open set lookup (for updating existing nodes)
-    std::unordered_map<int, Node*> openMap;
-
-    Node* startNode = new Node(startX, startY, 0, 0);  // No heuristic for Dijkstra
-    openSet.push(startNode);
-    openMap[startX * GRID_WIDTH + startY] = startNode;
-
-    while (!openSet.empty()) {
-        // Get node with lowest g-score
-        Node* current = openSet.top();
-        openSet.pop();
-
-        // Move from open to closed set
-        int currentKey = current->x * GRID_WIDTH + current->y;
-        openMap.erase(currentKey);
-        closedSet.insert(currentKey);
-
-        // Check if we reached the goal
-        if (current->x == goalX && current->y == goalY) {
-            std::vector<std::pair<int, int>> path = reconstructPath(current);
-
-            // Clean up memory
-            for (auto& pair : openMap) {
-                delete pair.second;
-            }
-
-            return path;
-        }
-
-        // Explore neighbors
-        std::vector<std::pair<int, int>> neighbors = getNeighbors(*current, maze);
-
-        for (const auto& neighbor : neighbors) {
-            int neighborX = neighbor.first;
-            int neighborY = neighbor.second;
-            int neighborKey = neighborX * GRID_WIDTH + neighborY;
-
-            // Skip if already in closed set
-            if (closedSet.find(neighborKey) != closedSet.end()) {
-                continue;
-            }
-
-            int tentativeG = current->g + 1;  // Each step costs 1
-
-            // Check if this path to neighbor is better
-            auto openIt = openMap.find(neighborKey);
-            if (openIt != openMap.end()) {
-                // Neighbor already in open set
-                Node* existingNode = openIt->second;
-                if (tentativeG < existingNode->g) {
-                    // better path to this neighbor
-                    existingNode->g = tentativeG;
-                    existingNode->f = existingNode->g;  // No heuristic for Dijkstra
-                    existingNode->parent = current;
-                }
-            } else {
-                // New node, add to open set
-                Node* neighborNode = new Node(neighborX, neighborY, tentativeG, 0, current);
-                openSet.push(neighborNode);
-                openMap[neighborKey] = neighborNode;
-            }
-        }
-    }
-
-    // Clean up remaining memory
-    for (auto& pair : openMap) {
-        delete pair.second;
-    }
-
-    return {};
+    return withGrid(maze, [&](const auto& grid) {
+        return findBestFirstPath<SearchOrder::DIJKSTRA>(grid, startX, startY, goalX, goalY, m_bestFirst);
+    });
 }
 
 std::vector<std::pair<int, int>> Pathfinder::findPathGreedy(int startX, int startY, int goalX, int goalY, const Maze& maze) {
@@ -236,77 +267,243 @@ std::vector<std::pair<int, int>> Pathfinder::findPathGreedy(int startX, int star
         return {};  // Invalid positions
     }
 
-    // Check if start and goal are the same
-    if (startX == goalX && startY == goalY) {
-        return {{startX, startY}};
-    }
+    return withGrid(maze, [&](const auto& grid) {
+        return findBestFirstPath<SearchOrder::GREEDY>(grid, startX, startY, goalX, goalY, m_bestFirst);
+    });
+}
 
-    // Priority queue for open set (min-heap based on h-score only)
-    std::priority_queue<Node*, std::vector<Node*>, NodeComparator> openSet;
+std::uint64_t Pathfinder::getExternalDistanceOffset(int gridWidth, int x, int y, int tileCells) {
+    const std::uint64_t tilesX = (gridWidth + tileCells - 1) / tileCells;
+    const std::uint64_t tile = static_cast<std::uint64_t>(y / tileCells) * tilesX + x / tileCells;
+    const std::uint64_t cell = static_cast<std::uint64_t>(y % tileCells) * tileCells + x % tileCells;
+    return (tile * tileCells * tileCells + cell) * sizeof(std::uint32_t);
+}
 
-    // Hash set for closed set (visited nodes)
-    std::unordered_set<int> closedSet;
+bool Pathfinder::buildExternalDistanceField(const MazeFile& maze, int targetX, int targetY,
+                                            const std::string& distancePath, ExternalStats& stats, int tileCells) {
+    const auto started = std::chrono::steady_clock::now();
+    stats = ExternalStats();
 
-    // Hash map for open set lookup (for updating existing nodes)
-    std::unordered_map<int, Node*> openMap;
+    const int gridWidth = maze.getGridWidth();
+    const int gridHeight = maze.getGridHeight();
+    if (tileCells < 1 || targetX < 0 || targetY < 0 || targetX >= gridWidth || targetY >= gridHeight ||
+        maze.isWall(targetX, targetY)) {
+        return false;
+    }
 
-    Node* startNode = new Node(startX, startY, 0, manhattanDistance(startX, startY, goalX, goalY));
-    openSet.push(startNode);
-    openMap[startX * GRID_WIDTH + startY] = startNode;
+    const int tile = tileCells;
+    const int tilesX = (gridWidth + tile - 1) / tile;
+    const int tilesY = (gridHeight + tile - 1) / tile;
+    const std::uint64_t tileCount = static_cast<std::uint64_t>(tilesX) * tilesY;
+    const size_t tileArea = static_cast<size_t>(tile) * tile;
+    const size_t tileBytes = tileArea * sizeof(std::uint32_t);
 
-    while (!openSet.empty()) {
-        // Get node with lowest h-score
-        Node* current = openSet.top();
-        openSet.pop();
+    std::fstream field(distancePath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!field) {
+        return false;
+    }
+    std::vector<bool> touched(tileCount, false);
+
+    // Frontier files: sweep s reads set s % 2 and writes the other (H = across columns, V = across rows)
+    const std::string spillPaths[2][2] = {{distancePath + ".h0", distancePath + ".v0"},
+                                          {distancePath + ".h1", distancePath + ".v1"}};
+
+    // One tile at a time: distances and walls with tile-wide rows
+    std::vector<std::uint32_t> distances(tileArea);
+    std::vector<std::uint8_t> walls(tileArea);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> seeds;  // (distance, cell)
+    std::vector<std::uint32_t> queue;
+
+    // Crossings ahead of the sweep stay in memory: the next tile in the row, and the row of tiles below (or above)
+    std::vector<Seed> aheadH;
+    std::vector<std::vector<Seed>> aheadV(tilesX);
+
+    const Seed start = {static_cast<std::uint64_t>(targetY / tile) * tilesX + targetX / tile,
+                        static_cast<std::uint32_t>((targetY % tile) * tile + targetX % tile), 0};
+
+    bool pending = true;
+    for (int direction = 1; pending; direction = -direction) {
+        const int in = stats.sweeps % 2;
+        SpillReader readH(spillPaths[in][0], stats.bytesRead);
+        SpillReader readV(spillPaths[in][1], stats.bytesRead);
+        SpillWriter writeH(spillPaths[1 - in][0], stats.bytesWritten);
+        SpillWriter writeV(spillPaths[1 - in][1], stats.bytesWritten);
+        int band = -1;
+
+        for (std::uint64_t step = 0; step < tileCount; ++step) {
+            const std::uint64_t index = direction > 0 ? step : tileCount - 1 - step;
+            const int tx = static_cast<int>(index % tilesX);
+            const int ty = static_cast<int>(index / tilesX);
+            if (ty != band) {
+                if (band >= 0) {
+                    maze.releaseRows(band * tile, std::min(gridHeight, (band + 1) * tile));
+                }
+                band = ty;
+            }
 
-        // Move from open to closed set
-        int currentKey = current->x * GRID_WIDTH + current->y;
-        openMap.erase(currentKey);
-        closedSet.insert(currentKey);
+            // Gather every seed for this tile; the readers hold them in sweep order
+            seeds.clear();
+            for (const Seed& seed : aheadH) seeds.push_back({seed.distance, seed.cell});
+            for (const Seed& seed : aheadV[tx]) seeds.push_back({seed.distance, seed.cell});
+            aheadH.clear();
+            aheadV[tx].clear();
+            for (SpillReader* reader : {&readH, &readV}) {
+                for (; reader->hasNext() && reader->peek().tile == index; reader->pop()) {
+                    seeds.push_back({reader->peek().distance, reader->peek().cell});
+                }
+            }
+            if (stats.sweeps == 0 && index == start.tile) {
+                seeds.push_back({start.distance, start.cell});
+            }
+            if (seeds.empty()) {
+                continue;
+            }
+            stats.tilesProcessed++;
 
-        // Check if we reached the goal
-        if (current->x == goalX && current->y == goalY) {
-            std::vector<std::pair<int, int>> path = reconstructPath(current);
+            const int originX = tx * tile;
+            const int originY = ty * tile;
+            const int width = std::min(tile, gridWidth - originX);
+            const int height = std::min(tile, gridHeight - originY);
 
-            // Clean up memory
-            for (auto& pair : openMap) {
-                delete pair.second;
+            if (touched[index]) {
+                field.seekg(static_cast<std::streamoff>(index * tileBytes));
+                field.read(reinterpret_cast<char*>(distances.data()), static_cast<std::streamsize>(tileBytes));
+                stats.bytesRead += tileBytes;
+            } else {
+                std::fill(distances.begin(), distances.end(), MazeFile::UNREACHABLE);
+            }
+            for (int y = 0; y < height; ++y) {
+                const std::uint8_t* bits = maze.getRowBits(originY + y);
+                for (int x = 0; x < width; ++x) {
+                    int gridX = originX + x;
+                    walls[y * tile + x] = (bits[gridX >> 3] >> (gridX & 7)) & 1;
+                }
+                stats.bytesRead += (width + 7) / 8;
             }
 
-            return path;
-        }
-
-        // Explore neighbors
-        std::vector<std::pair<int, int>> neighbors = getNeighbors(*current, maze);
+            // A crossing out of the tile becomes a seed of the neighbor tile
+            auto emit = [&](int gridX, int gridY, int dx, int dy, std::uint32_t distance) {
+                if (gridX < 0 || gridY < 0 || gridX >= gridWidth || gridY >= gridHeight || maze.isWall(gridX, gridY)) {
+                    return;
+                }
+                Seed seed = {index + dx + static_cast<std::int64_t>(dy) * tilesX,
+                             static_cast<std::uint32_t>((gridY % tile) * tile + gridX % tile), distance};
+                if (dx != 0) {
+                    if (dx == direction) {
+                        aheadH.push_back(seed);
+                    } else {
+                        writeH.push(seed);
+                    }
+                } else if (dy == direction) {
+                    aheadV[tx].push_back(seed);
+                } else {
+                    writeV.push(seed);
+                }
+            };
+
+            // BFS merged with the seeds in distance order, so each cell is settled once
+            std::sort(seeds.begin(), seeds.end());
+            queue.clear();
+            size_t head = 0;
+            size_t nextSeed = 0;
+            bool changed = false;
+            while (head < queue.size() || nextSeed < seeds.size()) {
+                std::uint32_t cell;
+                if (nextSeed < seeds.size() &&
+                    (head == queue.size() || seeds[nextSeed].first <= distances[queue[head]])) {
+                    std::uint32_t distance = seeds[nextSeed].first;
+                    cell = seeds[nextSeed++].second;
+                    if (distance >= distances[cell]) {
+                        continue;
+                    }
+                    distances[cell] = distance;
+                    changed = true;
+                } else {
+                    cell = queue[head++];
+                }
 
-        for (const auto& neighbor : neighbors) {
-            int neighborX = neighbor.first;
-            int neighborY = neighbor.second;
-            int neighborKey = neighborX * GRID_WIDTH + neighborY;
+                const std::uint32_t next = distances[cell] + 1;
+                const int x = static_cast<int>(cell % tile);
+                const int y = static_cast<int>(cell / tile);
+                auto relax = [&](int newX, int newY, int dx, int dy) {
+                    if (newX < 0 || newY < 0 || newX >= width || newY >= height) {
+                        emit(originX + newX, originY + newY, dx, dy, next);
+                        return;
+                    }
+                    std::uint32_t neighbor = static_cast<std::uint32_t>(newY * tile + newX);
+                    if (!walls[neighbor] && distances[neighbor] > next) {
+                        distances[neighbor] = next;
+                        queue.push_back(neighbor);
+                        changed = true;
+                    }
+                };
+                relax(x, y - 1, 0, -1);
+                relax(x, y + 1, 0, 1);
+                relax(x - 1, y, -1, 0);
+                relax(x + 1, y, 1, 0);
+            }
 
-            // Skip if already in closed set
-            if (closedSet.find(neighborKey) != closedSet.end()) {
-                continue;
+            if (changed) {
+                field.seekp(static_cast<std::streamoff>(index * tileBytes));
+                field.write(reinterpret_cast<const char*>(distances.data()), static_cast<std::streamsize>(tileBytes));
+                stats.bytesWritten += tileBytes;
+                touched[index] = true;
             }
+        }
+        if (band >= 0) {
+            maze.releaseRows(band * tile, std::min(gridHeight, (band + 1) * tile));
+        }
 
-            // For greedy, we only care about heuristic distance to goal
-            int h = manhattanDistance(neighborX, neighborY, goalX, goalY);
+        if (!writeH.finish() || !writeV.finish() || !field) {
+            return false;
+        }
+        pending = !writeH.isEmpty() || !writeV.isEmpty();
+        stats.sweeps++;
+    }
+    for (const auto& set : spillPaths) {
+        std::remove(set[0].c_str());
+        std::remove(set[1].c_str());
+    }
 
-            // Check if this neighbor is already in open set
-            auto openIt = openMap.find(neighborKey);
-            if (openIt == openMap.end()) {
-                // New node, add to open set
-                Node* neighborNode = new Node(neighborX, neighborY, 0, h, current);
-                openSet.push(neighborNode);
-                openMap[neighborKey] = neighborNode;
+    // Final pass in file order: fill tiles never reached, collect the statistics
+    const std::vector<std::uint32_t> unreachable(tileArea, MazeFile::UNREACHABLE);
+    for (std::uint64_t index = 0; index < tileCount; ++index) {
+        if (!touched[index]) {
+            field.seekp(static_cast<std::streamoff>(index * tileBytes));
+            field.write(reinterpret_cast<const char*>(unreachable.data()), static_cast<std::streamsize>(tileBytes));
+            stats.bytesWritten += tileBytes;
+            continue;
+        }
+        field.seekg(static_cast<std::streamoff>(index * tileBytes));
+        field.read(reinterpret_cast<char*>(distances.data()), static_cast<std::streamsize>(tileBytes));
+        stats.bytesRead += tileBytes;
+        for (std::uint32_t distance : distances) {
+            if (distance != MazeFile::UNREACHABLE) {
+                stats.reachedCells++;
+                stats.maxDistance = std::max(stats.maxDistance, distance);
             }
         }
     }
 
-    // Clean up remaining memory
-    for (auto& pair : openMap) {
-        delete pair.second;
+    // Open cells, a packed row at a time (bits past the width are zero, i.e. counted as open, so mask them)
+    const size_t usedBytes = (gridWidth + 7) / 8;
+    const std::uint8_t lastMask = static_cast<std::uint8_t>(gridWidth % 8 == 0 ? 0xFF : (1u << (gridWidth % 8)) - 1);
+    for (int y = 0; y < gridHeight; ++y) {
+        const std::uint8_t* bits = maze.getRowBits(y);
+        std::uint64_t wallCells = 0;
+        for (size_t byte = 0; byte + 1 < usedBytes; ++byte) {
+            wallCells += std::bitset<8>(bits[byte]).count();
+        }
+        wallCells += std::bitset<8>(bits[usedBytes - 1] & lastMask).count();
+        stats.openCells += gridWidth - wallCells;
+        stats.bytesRead += usedBytes;
+        if ((y + 1) % tile == 0 || y + 1 == gridHeight) {
+            maze.releaseRows(y - y % tile, y + 1);
+        }
     }
 
-    return {};
-}
\ No newline at end of file
+    field.flush();
+    stats.peakResidentBytes = peakResidentBytes();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return static_cast<bool>(field);
+}
@@ -1,36 +1,25 @@
 #pragma once
 
 #include <algorithm>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 #include "Config.h"
+#include "GridKernel.h"
 
+class MazeFile;
 
 /**
  * @brief A* pathfinding algorithm for grid-based mazes
  *
  * Finds the shortest path between two points using the A* algorithm
  * with Manhattan distance heuristic. Optimized for grid-based movement.
+ * A*, Dijkstra and greedy search all run findBestFirstPath on the grid
+ * snapshot, with flat per-cell scratch arrays instead of heap-allocated nodes.
  */
 class Pathfinder {
    public:
-    /**
-     * @brief Represents a node in the pathfinding grid
-     */
-    struct Node {
-        int x, y;      ///< Grid coordinates
-        int g;         ///< Cost from start to this node
-        int h;         ///< Heuristic cost to goal
-        int f;         ///< Total cost (g + h)
-        Node* parent;  ///< Parent node for path reconstruction
-
-        Node(int x, int y, int g, int h, Node* parent = nullptr)
-            : x(x), y(y), g(g), h(h), f(g + h), parent(parent) {}
-    };
-
     /**
      * @brief Finds the shortest path from start to goal using A* algorithm
      *
@@ -78,30 +67,143 @@ class Pathfinder {
      */
     static int manhattanDistance(int x1, int y1, int x2, int y2);
 
-   private:
     /**
-     * @brief Gets valid neighbors of a node
+     * @brief Gets the next step toward the player along a shared coarse route
      *
-     * @param node Current node
+     * @param x Current X coordinate
+     * @param y Current Y coordinate
+     * @param playerX Player's X coordinate
+     * @param playerY Player's Y coordinate
      * @param maze Reference to the maze for collision checking
-     * @return Vector of valid neighbor positions
+     * @return Adjacent cell one step closer to the player, or (x, y) if unreachable
+     *
+     * All far enemies share one BFS distance field, which is only rebuilt
+     * when the player enters a new sector of COARSE_FIELD_SECTOR_SIZE cells.
      */
-    std::vector<std::pair<int, int>> getNeighbors(const Node& node, const class Maze& maze);
+    std::pair<int, int> coarseStep(int x, int y, int playerX, int playerY, const class Maze& maze);
 
     /**
-     * @brief Reconstructs the path from goal to start
+     * @brief Builds the coarse distance field for the player's sector if it is stale
      *
-     * @param goalNode The goal node
-     * @return Vector of grid positions representing the path
+     * @param playerX Player's X coordinate
+     * @param playerY Player's Y coordinate
+     * @param maze Reference to the maze for collision checking
+     *
+     * Called by coarseStep; can also be called ahead of time (e.g. while the
+     * next round is prepared) so the first coarse step is free.
      */
-    std::vector<std::pair<int, int>> reconstructPath(Node* goalNode);
+    void prepareCoarseField(int playerX, int playerY, const class Maze& maze);
 
     /**
-     * @brief Custom comparator for priority queue (min-heap)
+     * @brief Discards the coarse distance field (call after the maze changes)
      */
-    struct NodeComparator {
-        bool operator()(const Node* a, const Node* b) const {
-            return a->f > b->f;  // Lower f-score has higher priority
-        }
+    void resetCoarseField();
+
+    /**
+     * @brief Takes over the coarse distance field and grid snapshot another pathfinder prepared
+     *
+     * @param prepared Pathfinder that ran prepareCoarseField, e.g. on a worker
+     *                 thread; left empty
+     *
+     * Lets a field be built where nothing else can see it and then installed
+     * on the thread that uses it. Its build counts toward getCoarseFieldBuildCount.
+     */
+    void adoptCoarseField(Pathfinder& prepared);
+
+    /**
+     * @brief Gets the number of times the coarse distance field was rebuilt
+     *
+     * @return Coarse field rebuild count
+     */
+    int getCoarseFieldBuildCount() const { return m_coarseFieldBuilds; }
+
+    /**
+     * @brief Results of an out-of-core distance field run
+     */
+    struct ExternalStats {
+        std::uint64_t reachedCells = 0;       ///< Cells with a finite distance
+        std::uint64_t openCells = 0;          ///< Open cells in the maze (all connected if equal to reachedCells)
+        std::uint32_t maxDistance = 0;        ///< Largest finite distance
+        int sweeps = 0;                       ///< Passes over the tiles
+        std::uint64_t tilesProcessed = 0;     ///< Tile relaxations over all sweeps
+        std::uint64_t bytesRead = 0;          ///< Maze, distance and frontier bytes read
+        std::uint64_t bytesWritten = 0;       ///< Distance and frontier bytes written
+        std::uint64_t peakResidentBytes = 0;  ///< Peak resident set size of the process
+        double seconds = 0.0;                 ///< Wall-clock time
     };
+
+    /**
+     * @brief Builds a BFS distance field over a mapped maze file, out of core
+     *
+     * @param maze Open maze file (may be far larger than memory)
+     * @param targetX Target X coordinate (must be open)
+     * @param targetY Target Y coordinate (must be open)
+     * @param distancePath File that receives the distances (see getExternalDistanceOffset)
+     * @param stats Receives counts, I/O volume, peak memory and time
+     * @param tileCells Side of a square tile in cells
+     * @return false if the target is a wall or a file could not be written
+     *
+     * The grid is cut into square tiles whose distances live in
+     * distancePath, tile after tile. Sweeps alternate between forward and
+     * backward tile order. Each tile with pending frontier seeds is read,
+     * relaxed with a BFS seeded in distance order, and written back.
+     * Crossings into tiles later in the sweep are kept in memory (one row
+     * of tiles); crossings against it are spilled to two frontier files.
+     * The next sweep reads those files backwards, which is the order it
+     * needs. This repeats until no seeds are left. Resident memory is one
+     * tile plus one row of tile edges; mapped maze rows are released band
+     * by band.
+     */
+    static bool buildExternalDistanceField(const MazeFile& maze, int targetX, int targetY,
+                                           const std::string& distancePath, ExternalStats& stats,
+                                           int tileCells = EXTERNAL_TILE_CELLS);
+
+    /**
+     * @brief Gets the byte offset of a cell's distance in an external distance field
+     *
+     * @param gridWidth Grid width of the maze
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @param tileCells Tile side the field was built with
+     * @return Offset of the cell's uint32 distance (MazeFile::UNREACHABLE = none)
+     */
+    static std::uint64_t getExternalDistanceOffset(int gridWidth, int x, int y, int tileCells = EXTERNAL_TILE_CELLS);
+
+   private:
+    /**
+     * @brief Runs a grid kernel on a snapshot of the maze
+     *
+     * @param maze Maze to search
+     * @param kernel Callable taking the grid; called with a DefaultGrid when
+     *               the maze has the stock size, otherwise with a DynamicGrid
+     * @return Whatever the kernel returns
+     *
+     * The snapshot is reloaded only when the maze version changes.
+     */
+    template <class Kernel>
+    auto withGrid(const class Maze& maze, Kernel&& kernel);
+
+    /**
+     * @brief Builds a BFS distance field from the target over the whole maze
+     *
+     * @param targetX Target X coordinate
+     * @param targetY Target Y coordinate
+     * @param maze Reference to the maze for collision checking
+     */
+    void buildCoarseField(int targetX, int targetY, const class Maze& maze);
+
+    // Grid kernels
+    DefaultGrid m_fixedGrid;            ///< Snapshot for stock-size mazes
+    DynamicGrid m_dynamicGrid;          ///< Snapshot for every other size
+    bool m_useFixedGrid = false;        ///< Which snapshot is current
+    std::uint64_t m_gridVersion = 0;    ///< Maze version the snapshot was taken from
+    std::vector<int> m_searchQueue;     ///< Scratch for the BFS kernels
+    BestFirstScratch m_bestFirst;       ///< Scratch for the A*, Dijkstra and greedy searches
+
+    std::vector<int> m_coarseField;   ///< BFS distance to the coarse target per grid storage index (-1 = unreachable)
+    int m_coarseStride = 0;           ///< Row stride of m_coarseField (grid width plus the border)
+    int m_coarseSectorX = -1;         ///< Player sector the coarse field was built for
+    int m_coarseSectorY = -1;         ///< Player sector the coarse field was built for
+    std::uint64_t m_coarseVersion = 0;  ///< Maze version the coarse field was built for
+    int m_coarseFieldBuilds = 0;      ///< Number of coarse field rebuilds
 };
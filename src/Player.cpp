@@ -44,7 +44,7 @@ void Player::handleInput(const Maze& maze, bool hasKey) {
 
     if (moved) {
         bool isValidPos = maze.isValidPosition(getX(), getY());
-        bool isWall = maze.isWall(getX(), getY());
+        bool isWall = isValidPos && maze.isWallUnchecked(getX(), getY());
         
         if (!isValidPos) {
             if (hasKey) {
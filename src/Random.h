@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+/**
+ * @brief Portable seeded random number generator (PCG32)
+ *
+ * std::mt19937 is portable, but std::uniform_int_distribution and
+ * std::shuffle are not: each standard library may map the same engine
+ * output to different values. Random pairs PCG32 with its own unbiased
+ * bounded integers (Lemire's method) and Fisher-Yates shuffle, so a seed
+ * gives the same maze on every compiler and platform.
+ *
+ * Satisfies UniformRandomBitGenerator, so it can still drive std algorithms
+ * where reproducibility doesn't matter.
+ */
+class Random {
+   public:
+    using result_type = std::uint32_t;
+
+    /**
+     * @brief Creates a generator from a 64-bit seed
+     *
+     * @param seed Seed value; equal seeds give equal sequences
+     */
+    explicit Random(std::uint64_t seed = 0) { reseed(seed); }
+
+    /**
+     * @brief Restarts the sequence from a seed
+     *
+     * @param seed Seed value
+     */
+    void reseed(std::uint64_t seed) {
+        m_state = 0;
+        m_increment = (mix(seed) << 1) | 1;
+        (*this)();
+        m_state += seed;
+        (*this)();
+    }
+
+    /**
+     * @brief Gets the next 32 random bits
+     */
+    result_type operator()() {
+        std::uint64_t old = m_state;
+        m_state = old * 6364136223846793005ull + m_increment;
+        auto xorShifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        auto rotation = static_cast<std::uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31));
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    /**
+     * @brief Gets an unbiased integer in [low, high]
+     *
+     * @param low Smallest value
+     * @param high Largest value (at least low)
+     * @return Uniformly distributed integer
+     */
+    int uniformInt(int low, int high) {
+        auto range = static_cast<std::uint32_t>(static_cast<std::int64_t>(high) - low + 1);
+        return low + static_cast<int>(bounded(range));
+    }
+
+    /**
+     * @brief Returns true with the given probability in percent
+     *
+     * @param percent Chance from 0 to 100
+     */
+    bool chance(int percent) { return uniformInt(0, 99) < percent; }
+
+    /**
+     * @brief Shuffles a range (Fisher-Yates)
+     *
+     * @param first Start of the range
+     * @param last End of the range
+     */
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last) {
+        auto count = static_cast<std::uint32_t>(std::distance(first, last));
+        for (std::uint32_t i = count; i > 1; --i) {
+            std::uint32_t j = bounded(i);
+            using std::swap;
+            swap(first[i - 1], first[j]);
+        }
+    }
+
+    /**
+     * @brief SplitMix64 finalizer, for deriving independent seeds from coordinates
+     *
+     * @param value Input value
+     * @return Well-mixed 64-bit hash
+     */
+    static std::uint64_t mix(std::uint64_t value) {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+   private:
+    /**
+     * @brief Gets an unbiased integer in [0, range) (range 0 means 2^32)
+     */
+    std::uint32_t bounded(std::uint32_t range) {
+        if (range == 0) {
+            return (*this)();
+        }
+        std::uint64_t product = static_cast<std::uint64_t>((*this)()) * range;
+        auto low = static_cast<std::uint32_t>(product);
+        if (low < range) {
+            std::uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                product = static_cast<std::uint64_t>((*this)()) * range;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32);
+    }
+
+    std::uint64_t m_state;      ///< LCG state
+    std::uint64_t m_increment;  ///< LCG increment (stream selector, always odd)
+};
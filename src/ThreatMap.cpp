@@ -0,0 +1,285 @@
+#include "ThreatMap.h"
+
+#include <algorithm>
+#include <iterator>
+#include <queue>
+
+#include "Enemy.h"
+#include "Maze.h"
+
+void ThreatMap::update(const std::vector<Enemy>& enemies, const Maze& maze) {
+    // Group current enemy positions by speed
+    std::vector<SpeedGroup> groups;
+    for (const auto& enemy : enemies) {
+        auto it = std::find_if(groups.begin(), groups.end(), [&](const SpeedGroup& group) {
+            return group.moveDelay == enemy.getMoveDelay();
+        });
+        if (it == groups.end()) {
+            groups.push_back({enemy.getMoveDelay(), {}, {}, {}, 0});
+            it = groups.end() - 1;
+        }
+        it->sources.push_back(enemy.getPosition());
+    }
+
+    // An edited maze changes walking distances everywhere, so no layer survives it
+    bool mazeChanged = maze.getVersion() != m_mazeVersion;
+    bool rebuild = mazeChanged || groups.size() != m_groups.size() || m_timeToReach.empty();
+    m_mazeVersion = maze.getVersion();
+
+    // Repair layers whose speed is already known, expand new speeds from scratch
+    std::vector<int> changedCells;
+    for (auto& group : groups) {
+        auto cached = std::find_if(m_groups.begin(), m_groups.end(), [&](const SpeedGroup& old) {
+            return !mazeChanged && old.moveDelay == group.moveDelay;
+        });
+        if (cached != m_groups.end()) {
+            if (cached->sources != group.sources && !moveSources(*cached, group.sources, maze, changedCells)) {
+                rebuild = true;
+            }
+            group.steps = std::move(cached->steps);
+            group.nearestSource = std::move(cached->nearestSource);
+            group.reachable = cached->reachable;
+        } else {
+            expandGroup(group, maze);
+            rebuild = true;
+        }
+    }
+
+    m_groups = std::move(groups);
+
+    auto combine = [this](size_t index) {
+        float time = THREAT_UNREACHABLE;
+        for (const auto& group : m_groups) {
+            if (group.steps[index] >= 0) {
+                time = std::min(time, group.steps[index] * group.moveDelay);
+            }
+        }
+        m_timeToReach[index] = time;
+    };
+
+    if (!rebuild) {
+        for (int index : changedCells) {
+            combine(index);
+        }
+        return;
+    }
+
+    m_width = maze.getGridWidth();
+    m_height = maze.getGridHeight();
+    m_timeToReach.resize(m_width * m_height);
+    for (size_t i = 0; i < m_timeToReach.size(); ++i) {
+        combine(i);
+    }
+}
+
+void ThreatMap::reset() {
+    m_groups.clear();
+    m_timeToReach.clear();
+    m_width = 0;
+    m_height = 0;
+    m_mazeVersion = 0;
+}
+
+float ThreatMap::getTimeToReach(int x, int y) const {
+    if (m_timeToReach.empty() || x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return THREAT_UNREACHABLE;
+    }
+    return m_timeToReach[y * m_width + x];
+}
+
+void ThreatMap::render(sf::RenderWindow& window) const {
+    if (m_timeToReach.empty()) {
+        return;
+    }
+
+    sf::RectangleShape cell;
+    cell.setSize(sf::Vector2f(CELL_SIZE, CELL_SIZE));
+
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            float time = m_timeToReach[y * m_width + x];
+            if (time >= THREAT_OVERLAY_HORIZON) {
+                continue;
+            }
+
+            // Sooner threats are drawn more opaque
+            float urgency = 1.0f - time / THREAT_OVERLAY_HORIZON;
+            cell.setFillColor(sf::Color(THREAT_COLOR.r, THREAT_COLOR.g, THREAT_COLOR.b,
+                                        static_cast<std::uint8_t>(THREAT_COLOR.a * urgency)));
+            cell.setPosition(sf::Vector2f(x * CELL_SIZE, y * CELL_SIZE));
+            window.draw(cell);
+        }
+    }
+}
+
+void ThreatMap::expandGroup(SpeedGroup& group, const Maze& maze) const {
+    const int gridWidth = maze.getGridWidth();
+    group.steps.assign(gridWidth * maze.getGridHeight(), -1);
+    group.nearestSource.assign(group.steps.size(), -1);
+    group.reachable = 0;
+
+    std::queue<std::pair<int, int>> frontier;
+    for (const auto& source : group.sources) {
+        int index = source.second * gridWidth + source.first;
+        if (maze.isValidPosition(source.first, source.second) && group.steps[index] < 0) {
+            group.steps[index] = 0;
+            group.nearestSource[index] = index;
+            group.reachable++;
+            frontier.push(source);
+        }
+    }
+
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    while (!frontier.empty()) {
+        auto [x, y] = frontier.front();
+        frontier.pop();
+        int index = y * gridWidth + x;
+        int steps = group.steps[index];
+
+        for (int i = 0; i < 4; ++i) {
+            int newX = x + directions[i][0];
+            int newY = y + directions[i][1];
+            int newIndex = newY * gridWidth + newX;
+
+            if (!maze.isWallUnchecked(newX, newY) && group.steps[newIndex] < 0) {
+                group.steps[newIndex] = steps + 1;
+                group.nearestSource[newIndex] = group.nearestSource[index];
+                group.reachable++;
+                frontier.push({newX, newY});
+            }
+        }
+    }
+}
+
+bool ThreatMap::moveSources(SpeedGroup& group, const std::vector<std::pair<int, int>>& sources, const Maze& maze,
+                            std::vector<int>& changedCells) const {
+    const int gridWidth = maze.getGridWidth();
+
+    // Several enemies can share a cell, so compare the sets of source cells
+    auto sourceCells = [&](const std::vector<std::pair<int, int>>& positions) {
+        std::vector<int> cells;
+        for (const auto& position : positions) {
+            if (maze.isValidPosition(position.first, position.second)) {
+                cells.push_back(position.second * gridWidth + position.first);
+            }
+        }
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        return cells;
+    };
+    std::vector<int> before = sourceCells(group.sources);
+    std::vector<int> after = sourceCells(sources);
+    group.sources = sources;
+
+    std::vector<int> removed;
+    std::vector<int> added;
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(removed));
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(added));
+
+    // With no source cell kept, every distance in the layer changes
+    if (removed.size() == before.size()) {
+        expandGroup(group, maze);
+        return false;
+    }
+
+    int directions[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+    // Bucket queue: seeds start at different step counts, so plain BFS order isn't enough
+    std::vector<std::vector<int>> buckets;
+    auto push = [&](int index, int steps) {
+        if (steps >= static_cast<int>(buckets.size())) {
+            buckets.resize(steps + 1);
+        }
+        buckets[steps].push_back(index);
+    };
+    auto assign = [&](int index, int steps, int source) {
+        group.reachable += group.steps[index] < 0;
+        group.steps[index] = steps;
+        group.nearestSource[index] = source;
+        changedCells.push_back(index);
+        push(index, steps);
+    };
+    auto relax = [&]() {
+        for (size_t steps = 0; steps < buckets.size(); ++steps) {
+            for (size_t i = 0; i < buckets[steps].size(); ++i) {
+                int index = buckets[steps][i];
+                if (group.steps[index] != static_cast<int>(steps)) {
+                    continue;  // Lowered again after it was queued
+                }
+                int x = index % gridWidth;
+                int y = index / gridWidth;
+
+                for (int d = 0; d < 4; ++d) {
+                    int newX = x + directions[d][0];
+                    int newY = y + directions[d][1];
+                    if (maze.isWallUnchecked(newX, newY)) {
+                        continue;
+                    }
+                    int newIndex = newY * gridWidth + newX;
+                    if (group.steps[newIndex] < 0 || group.steps[newIndex] > static_cast<int>(steps) + 1) {
+                        assign(newIndex, static_cast<int>(steps) + 1, group.nearestSource[index]);
+                    }
+                }
+            }
+        }
+        buckets.clear();
+    };
+
+    // New sources take over the cells they are strictly closer to
+    for (int source : added) {
+        assign(source, 0, source);
+    }
+    relax();
+
+    // A cell still counted from a removed source hangs off it through cells counted from it too
+    const size_t maxCleared = static_cast<size_t>(group.reachable) * THREAT_REPAIR_MAX_PERCENT / 100;
+    std::vector<int> cleared;
+    for (int source : removed) {
+        if (group.nearestSource[source] == source) {
+            group.steps[source] = -1;
+            group.nearestSource[source] = -1;
+            cleared.push_back(source);
+        }
+    }
+    for (size_t i = 0; i < cleared.size(); ++i) {
+        if (cleared.size() > maxCleared) {
+            expandGroup(group, maze);
+            return false;
+        }
+        int x = cleared[i] % gridWidth;
+        int y = cleared[i] / gridWidth;
+        for (int d = 0; d < 4; ++d) {
+            int newX = x + directions[d][0];
+            int newY = y + directions[d][1];
+            if (maze.isWallUnchecked(newX, newY)) {
+                continue;
+            }
+            int newIndex = newY * gridWidth + newX;
+            int source = group.nearestSource[newIndex];
+            if (source >= 0 && std::binary_search(removed.begin(), removed.end(), source)) {
+                group.steps[newIndex] = -1;
+                group.nearestSource[newIndex] = -1;
+                cleared.push_back(newIndex);
+            }
+        }
+    }
+    group.reachable -= static_cast<int>(cleared.size());
+
+    // The intact cells bordering the cleared area refill it from their unchanged steps
+    for (int index : cleared) {
+        changedCells.push_back(index);
+        int x = index % gridWidth;
+        int y = index / gridWidth;
+        for (int d = 0; d < 4; ++d) {
+            int newX = x + directions[d][0];
+            int newY = y + directions[d][1];
+            int newIndex = newY * gridWidth + newX;
+            if (!maze.isWallUnchecked(newX, newY) && group.steps[newIndex] >= 0) {
+                push(newIndex, group.steps[newIndex]);
+            }
+        }
+    }
+    relax();
+    return true;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Config.h"
+
+// Forward declarations
+class Enemy;
+class Maze;
+
+/**
+ * @brief Time-to-reach field: the earliest time any enemy could reach each cell
+ *
+ * Enemies are grouped by move delay and each group is expanded with one
+ * multi-source BFS, so the whole field costs one linear pass per distinct
+ * enemy speed instead of a search per enemy. After that, an enemy changing
+ * cell only re-relaxes the cells its old and new cell were nearest to, and
+ * only those cells are recombined into the field. A lone enemy of its speed
+ * moves every distance in its layer, which is then simply re-expanded.
+ */
+class ThreatMap {
+   public:
+    /**
+     * @brief Updates the field from the current enemy positions
+     *
+     * @param enemies All enemies in the round
+     * @param maze Reference to the maze for collision checking
+     *
+     * Groups whose enemies changed cell are repaired in place (see
+     * moveSources); a group is re-expanded in full when its speed is new,
+     * the maze was edited or the move affects most of its layer.
+     */
+    void update(const std::vector<Enemy>& enemies, const Maze& maze);
+
+    /**
+     * @brief Discards all cached layers (call after the maze changes)
+     */
+    void reset();
+
+    /**
+     * @brief Gets the earliest time any enemy could reach a cell
+     *
+     * @param x X coordinate in grid space
+     * @param y Y coordinate in grid space
+     * @return Seconds until the cell can be reached (THREAT_UNREACHABLE if never)
+     */
+    float getTimeToReach(int x, int y) const;
+
+    /**
+     * @brief Draws a red tint over cells enemies can reach soon
+     *
+     * @param window Reference to the SFML render window
+     *
+     * Cells reachable within THREAT_OVERLAY_HORIZON seconds are tinted,
+     * stronger the sooner an enemy could get there.
+     */
+    void render(sf::RenderWindow& window) const;
+
+   private:
+    /**
+     * @brief Enemies sharing one move delay, expanded together
+     */
+    struct SpeedGroup {
+        float moveDelay;                            ///< Seconds per move for every enemy in the group
+        std::vector<std::pair<int, int>> sources;   ///< Enemy cells seeding the BFS
+        std::vector<int> steps;                     ///< BFS steps from the nearest source (-1 = unreachable)
+        std::vector<int> nearestSource;             ///< Per cell: index of the source cell steps counts from (-1 = unreachable)
+        int reachable = 0;                          ///< Cells with steps >= 0
+    };
+
+    /**
+     * @brief Runs the multi-source BFS for one speed group
+     *
+     * @param group Group whose steps are rebuilt from its sources
+     * @param maze Reference to the maze for collision checking
+     */
+    void expandGroup(SpeedGroup& group, const Maze& maze) const;
+
+    /**
+     * @brief Repairs a group's layer after some of its enemies changed cell
+     *
+     * @param group Group expanded on the current maze
+     * @param sources New enemy cells of the group
+     * @param maze Reference to the maze for collision checking
+     * @param changedCells Receives the index of every cell whose steps were rewritten
+     * @return false if the layer was re-expanded in full instead (every cell may have changed)
+     *
+     * New source cells first take over every cell they are strictly closer
+     * to. Cells still counted from a source cell that was left are then
+     * cleared and refilled from the intact cells around them. Both searches
+     * stop where steps stop changing, so a move costs the cells it affects,
+     * not the grid. When every source cell was left, or the cleared cells
+     * pass THREAT_REPAIR_MAX_PERCENT of the layer, one full BFS is cheaper
+     * and the layer is re-expanded instead.
+     */
+    bool moveSources(SpeedGroup& group, const std::vector<std::pair<int, int>>& sources, const Maze& maze,
+                     std::vector<int>& changedCells) const;
+
+    std::vector<SpeedGroup> m_groups;   ///< One BFS layer per distinct enemy speed
+    std::vector<float> m_timeToReach;   ///< Combined field: min over groups of steps * moveDelay
+    int m_width = 0;                    ///< Grid width the field was built for
+    int m_height = 0;                   ///< Grid height the field was built for
+    std::uint64_t m_mazeVersion = 0;    ///< Maze version the layers were expanded on
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <numeric>
+#include <vector>
+
+/**
+ * @brief Disjoint-set forest with path halving and union by size
+ *
+ * Used to join independently generated maze regions into one connected maze.
+ */
+class UnionFind {
+   public:
+    /**
+     * @brief Creates count singleton sets, numbered 0 to count - 1
+     *
+     * @param count Number of elements
+     */
+    explicit UnionFind(int count) : m_parent(count), m_size(count, 1), m_sets(count) {
+        std::iota(m_parent.begin(), m_parent.end(), 0);
+    }
+
+    /**
+     * @brief Finds the representative of an element's set
+     *
+     * @param element Element index
+     * @return Representative element index
+     */
+    int find(int element) {
+        while (m_parent[element] != element) {
+            m_parent[element] = m_parent[m_parent[element]];
+            element = m_parent[element];
+        }
+        return element;
+    }
+
+    /**
+     * @brief Merges the sets containing two elements
+     *
+     * @param a First element
+     * @param b Second element
+     * @return true if they were in different sets
+     */
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (m_size[a] < m_size[b]) {
+            std::swap(a, b);
+        }
+        m_parent[b] = a;
+        m_size[a] += m_size[b];
+        m_sets--;
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of disjoint sets
+     *
+     * @return Set count
+     */
+    int getSetCount() const { return m_sets; }
+
+   private:
+    std::vector<int> m_parent;  ///< Parent links; roots point to themselves
+    std::vector<int> m_size;    ///< Set size, valid at roots
+    int m_sets;                 ///< Number of disjoint sets
+};
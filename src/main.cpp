@@ -1,14 +1,95 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
 #include "Game.h"
+#include "MazeImage.h"
 
 /**
  * @brief Entry point of the application
  *
  * Creates a Game instance and starts the main game loop.
  *
+ * Usage: Oubliette [--width N] [--height N] [--size N] [--endless] [--generator NAME]
+ *                  [--image PATH] [--image-cell N]
+ * Sizes are in logical maze cells (default 21x21). --endless plays in an
+ * endless chunked world instead, so the size options are ignored.
+ * --generator picks the carving algorithm: dfs (default), kruskal, prim, wilson or caves.
+ * --image plays every round on a maze drawn as an image (dark = wall), each
+ * cell --image-cell pixels square (default 1); the size options are ignored.
+ *
  * @return int Exit code (0 for successful execution)
  */
-int main() {
-    Game game;
+int main(int argc, char* argv[]) {
+    int mazeWidth = DEFAULT_MAZE_WIDTH;
+    int mazeHeight = DEFAULT_MAZE_HEIGHT;
+    bool endless = false;
+    MazeAlgorithm algorithm = MazeAlgorithm::DFS;
+    std::string imagePath;
+    int imageCellPixels = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--endless") {
+            endless = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cout << "Missing value for " << flag << std::endl;
+            break;
+        }
+        if (flag == "--generator") {
+            const Maze::Generator* generator = Maze::findGenerator(argv[++i]);
+            if (generator) {
+                algorithm = generator->algorithm;
+            } else {
+                std::cout << "Unknown generator " << argv[i] << std::endl;
+            }
+            continue;
+        }
+        if (flag == "--image") {
+            imagePath = argv[++i];
+            continue;
+        }
+        if (flag == "--image-cell") {
+            imageCellPixels = std::max(1, std::atoi(argv[++i]));
+            continue;
+        }
+        int value = std::max(MIN_MAZE_SIZE, std::atoi(argv[++i]));
+
+        if (flag == "--width") {
+            mazeWidth = value;
+        } else if (flag == "--height") {
+            mazeHeight = value;
+        } else if (flag == "--size") {
+            mazeWidth = value;
+            mazeHeight = value;
+        } else {
+            std::cout << "Unknown option " << flag << std::endl;
+        }
+    }
+
+    if (endless) {
+        mazeWidth = ENDLESS_WINDOW_CHUNKS * ENDLESS_CHUNK_CELLS;
+        mazeHeight = ENDLESS_WINDOW_CHUNKS * ENDLESS_CHUNK_CELLS;
+    }
+
+    std::unique_ptr<Maze> arena;
+    if (!imagePath.empty() && !endless) {
+        MazeImage image;
+        MazeImage::Status status = image.load(imagePath, imageCellPixels);
+        if (status == MazeImage::Status::OK) {
+            arena = std::make_unique<Maze>(image);
+            mazeWidth = arena->getGridWidth() / 2;
+            mazeHeight = arena->getGridHeight() / 2;
+        } else {
+            std::cout << "Could not load " << imagePath << ": " << MazeImage::describe(status) << std::endl;
+        }
+    }
+
+    Game game(mazeWidth, mazeHeight, endless, algorithm, arena.get());
     game.run();
     return 0;
 }
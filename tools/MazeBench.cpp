@@ -0,0 +1,845 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BitGrid.h"
+#include "GridKernel.h"
+#include "GridStorage.h"
+#include "Maze.h"
+#include "MazeFile.h"
+#include "MazeImage.h"
+#include "Pathfinder.h"
+#include "Random.h"
+
+/**
+ * @file MazeBench.cpp
+ * @brief Throughput benchmarks for maze storage and search
+ *
+ * Usage: MazeBench [section] [max]
+ *
+ * Sections (all run when none is given):
+ * - layout [maxSide]: BFS and A* over square grids from 1024^2 up to
+ *   maxSide^2 (default 4096) for every GridLayout
+ * - generate [maxCells]: DFS generation from 21x21 up to maxCells^2 logical
+ *   cells (default 8192), single-threaded and tiled on 1..N threads
+ * - eller [width]: streams 16384 rows of a width-wide Eller maze (default
+ *   1024) to a checksum, never holding the maze in memory
+ * - file [maxCells]: writes seeded mazes from 256^2 up to maxCells^2
+ *   (default 4096) to a MazeFile and times mapping and loading them
+ * - edit [maxCells]: single-cell edit followed by snap / line-of-sight
+ *   queries, against a full rebuild and a full regenerate, from 64^2 up to
+ *   maxCells^2 (default 1024)
+ * - kernel [iterations]: distance field, shortest path and wall-mask
+ *   kernels on the stock 43x43 maze, FixedGrid vs DynamicGrid vs reading
+ *   the Maze directly (default 20000 iterations)
+ * - share [matches]: one seeded maze shared by many match copies (default
+ *   1000): memory per copy, and the cost of the first edit on a copy
+ * - algorithms [maxCells]: carving throughput and peak scratch memory of
+ *   every registered generator from 1024^2 up to maxCells^2 logical cells
+ *   (default 4096; 16384 needs several GB of memory)
+ * - caves [maxSide]: cave automaton generations, bit-sliced stepLifeLike
+ *   vs a byte-per-cell scalar step, from 1024^2 up to maxSide^2 grid
+ *   cells (default 4096)
+ * - image [side]: imports a side x side RGBA image (default 8192, already
+ *   decoded) at 1, 4 and 16 pixels per cell
+ * - external [cells]: streams a cells^2 Eller maze (default 4096) to a
+ *   MazeFile and builds its distance field out of core at several tile
+ *   sizes: sweeps, I/O volume, peak resident memory, checked against an
+ *   in-memory BFS
+ */
+
+namespace {
+
+// Heap accounting for the algorithms section: every allocation carries its
+// size in a header so the live byte count and its peak can be tracked
+const size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+std::atomic<size_t> g_liveBytes{0};
+std::atomic<size_t> g_peakBytes{0};
+
+void* countedAlloc(size_t size) {
+    auto* block = static_cast<unsigned char*>(std::malloc(size + ALLOCATION_HEADER));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    size_t live = g_liveBytes.fetch_add(size) + size;
+    size_t peak = g_peakBytes.load();
+    while (live > peak && !g_peakBytes.compare_exchange_weak(peak, live)) {
+    }
+    return block + ALLOCATION_HEADER;
+}
+
+void countedFree(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(pointer) - ALLOCATION_HEADER;
+    g_liveBytes.fetch_sub(*reinterpret_cast<size_t*>(block));
+    std::free(block);
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void* pointer) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { countedFree(pointer); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* layoutName(GridLayout layout) {
+    switch (layout) {
+        case GridLayout::TILED:
+            return "tiled";
+        case GridLayout::MORTON:
+            return "morton";
+        case GridLayout::ROW_MAJOR:
+        default:
+            return "row-major";
+    }
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Carves a perfect binary-tree maze (each odd cell opens north or east)
+ */
+void carveBinaryTreeMaze(GridStorage& grid, unsigned seed) {
+    Random rng(seed);
+    grid.fill(CELL_WALL);
+
+    for (int y = 1; y < grid.getHeight() - 1; y += 2) {
+        for (int x = 1; x < grid.getWidth() - 1; x += 2) {
+            grid.at(x, y) = CELL_EMPTY;
+            bool canNorth = y > 1;
+            bool canEast = x < grid.getWidth() - 3;
+            if (canNorth && (!canEast || (rng() & 1))) {
+                grid.at(x, y - 1) = CELL_EMPTY;
+            } else if (canEast) {
+                grid.at(x + 1, y) = CELL_EMPTY;
+            }
+        }
+    }
+}
+
+const int DIRECTIONS[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+/**
+ * @brief Full BFS flood from (startX, startY); returns the number of cells reached
+ */
+size_t bfs(const GridStorage& grid, int startX, int startY) {
+    std::vector<int> dist(grid.size(), -1);
+    std::vector<std::pair<int, int>> queue;
+    queue.reserve(static_cast<size_t>(grid.getWidth()) * grid.getHeight() / 2);
+
+    dist[grid.index(startX, startY)] = 0;
+    queue.push_back({startX, startY});
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        auto [x, y] = queue[head];
+        int d = dist[grid.index(x, y)];
+        for (const auto& dir : DIRECTIONS) {
+            int nx = x + dir[0];
+            int ny = y + dir[1];
+            size_t n = grid.index(nx, ny);
+            if (grid.get(nx, ny) != CELL_WALL && dist[n] < 0) {
+                dist[n] = d + 1;
+                queue.push_back({nx, ny});
+            }
+        }
+    }
+    return queue.size();
+}
+
+/**
+ * @brief A* with a Manhattan heuristic; returns the number of expanded nodes
+ */
+size_t aStar(const GridStorage& grid, int startX, int startY, int goalX, int goalY) {
+    struct Entry {
+        int f, x, y;
+        bool operator>(const Entry& other) const { return f > other.f; }
+    };
+
+    std::vector<int> g(grid.size(), -1);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    auto h = [&](int x, int y) { return std::abs(x - goalX) + std::abs(y - goalY); };
+
+    g[grid.index(startX, startY)] = 0;
+    open.push({h(startX, startY), startX, startY});
+    size_t expanded = 0;
+
+    while (!open.empty()) {
+        Entry current = open.top();
+        open.pop();
+        int currentG = g[grid.index(current.x, current.y)];
+        if (current.f > currentG + h(current.x, current.y)) {
+            continue;  // Stale entry
+        }
+        expanded++;
+        if (current.x == goalX && current.y == goalY) {
+            break;
+        }
+        for (const auto& dir : DIRECTIONS) {
+            int nx = current.x + dir[0];
+            int ny = current.y + dir[1];
+            size_t n = grid.index(nx, ny);
+            if (grid.get(nx, ny) != CELL_WALL && (g[n] < 0 || currentG + 1 < g[n])) {
+                g[n] = currentG + 1;
+                open.push({g[n] + h(nx, ny), nx, ny});
+            }
+        }
+    }
+    return expanded;
+}
+
+void benchLayouts(int side) {
+    const GridLayout layouts[] = {GridLayout::ROW_MAJOR, GridLayout::TILED, GridLayout::MORTON};
+
+    for (GridLayout layout : layouts) {
+        GridStorage grid(side, side, layout);
+        carveBinaryTreeMaze(grid, 1234);
+
+        auto start = Clock::now();
+        size_t reached = bfs(grid, 1, 1);
+        double bfsSeconds = secondsSince(start);
+
+        start = Clock::now();
+        size_t expanded = aStar(grid, 1, side - 2 - (side % 2 == 0), side - 2 - (side % 2 == 0), 1);
+        double aStarSeconds = secondsSince(start);
+
+        std::printf("%6d^2  %-9s  BFS %8.1f Mcells/s  A* %8.1f Mnodes/s  (%zu bytes)\n",
+                    side, layoutName(layout), reached / bfsSeconds / 1e6, expanded / aStarSeconds / 1e6, grid.size());
+    }
+}
+
+void benchLayoutSection(int maxSide) {
+    std::printf("Layout benchmark: BFS flood and corner-to-corner A*\n");
+    for (int side = 1024; side <= maxSide; side *= 2) {
+        benchLayouts(side + 1);  // Odd sides keep the maze border closed
+    }
+}
+
+void benchGenerateSection(int maxCells) {
+    std::printf("Generation benchmark: iterative DFS carving / full Maze::regenerate\n");
+
+    std::vector<int> sizes = {21};
+    for (int cells = 64; cells <= maxCells; cells *= 4) {
+        sizes.push_back(cells);
+    }
+    if (sizes.back() != maxCells && maxCells > 21) {
+        sizes.push_back(maxCells);
+    }
+
+    for (int cells : sizes) {
+        int side = cells * 2 + 1;
+        GridStorage grid(side, side);
+        Random rng(42);
+
+        auto start = Clock::now();
+        Maze::carveDFS(grid, cells | 1, cells | 1, rng);
+        double seconds = secondsSince(start);
+
+        Maze maze(cells, cells);
+        start = Clock::now();
+        maze.regenerate();
+        double regenerateSeconds = secondsSince(start);
+
+        double logicalCells = static_cast<double>(cells) * cells;
+        std::printf("%5dx%-5d  carve %8.3f s (%7.2f Mcells/s)  regenerate %8.3f s (%7.2f Mcells/s)\n", cells, cells,
+                    seconds, logicalCells / seconds / 1e6, regenerateSeconds, logicalCells / regenerateSeconds / 1e6);
+
+        // Tiled carving on a doubling thread count up to the core count
+        int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        for (int threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+            GridStorage tiledGrid(side, side);
+            start = Clock::now();
+            Maze::carveTiled(tiledGrid, 42, threads);
+            double tiledSeconds = secondsSince(start);
+            std::printf("             tiled %2d threads %8.3f s (%7.2f Mcells/s)\n", threads, tiledSeconds,
+                        logicalCells / tiledSeconds / 1e6);
+            if (threads == maxThreads) {
+                break;
+            }
+        }
+    }
+}
+
+void benchEllerSection(int width) {
+    std::printf("Streaming benchmark: Eller's algorithm\n");
+
+    const int height = 16384;
+    Random rng(42);
+    std::uint64_t checksum = 0;
+    std::uint64_t openCells = 0;
+
+    auto start = Clock::now();
+    Maze::streamEller(width, height, rng, [&](int gridY, const std::uint8_t* row, int gridWidth) {
+        for (int x = 0; x < gridWidth; ++x) {
+            openCells += row[x] == CELL_EMPTY;
+        }
+        checksum = checksum * 31 + gridY;
+    });
+    double seconds = secondsSince(start);
+
+    std::printf("%d x %d logical cells  %8.3f s  %10.0f rows/s  %8.2f Mcells/s  (%llu open, checksum %llx)\n",
+                width, height, seconds, height / seconds, static_cast<double>(width) * height / seconds / 1e6,
+                static_cast<unsigned long long>(openCells), static_cast<unsigned long long>(checksum));
+}
+
+void benchFileSection(int maxCells) {
+    std::printf("File benchmark: write / map / verify / load into Maze\n");
+
+    const std::string path = "MazeBench.maze";
+    for (int cells = 256; cells <= maxCells; cells *= 2) {
+        Maze maze(cells, cells, GridLayout::ROW_MAJOR, 42);
+
+        auto start = Clock::now();
+        if (!MazeFile::write(path, maze, true)) {
+            std::printf("Could not write %s\n", path.c_str());
+            return;
+        }
+        double writeSeconds = secondsSince(start);
+
+        MazeFile file;
+        start = Clock::now();
+        bool opened = file.open(path);
+        double openSeconds = secondsSince(start);
+        if (!opened) {
+            std::printf("Could not map %s\n", path.c_str());
+            return;
+        }
+
+        start = Clock::now();
+        bool intact = file.verifyChecksum();
+        double verifySeconds = secondsSince(start);
+
+        start = Clock::now();
+        Maze loaded(file);
+        double loadSeconds = secondsSince(start);
+
+        // A seeded maze must regenerate identically, and the file must round-trip it
+        Maze regenerated(cells, cells, GridLayout::ROW_MAJOR, 42);
+        bool identical = true;
+        for (int y = 0; y < maze.getGridHeight() && identical; ++y) {
+            for (int x = 0; x < maze.getGridWidth(); ++x) {
+                if (maze.isWallUnchecked(x, y) != loaded.isWallUnchecked(x, y) ||
+                    maze.isWallUnchecked(x, y) != regenerated.isWallUnchecked(x, y)) {
+                    identical = false;
+                    break;
+                }
+            }
+        }
+
+        std::printf("%5dx%-5d  write %7.3f s  map %9.6f s  verify %7.3f s  load %7.3f s  %s%s\n", cells, cells,
+                    writeSeconds, openSeconds, verifySeconds, loadSeconds, intact ? "checksum ok" : "CHECKSUM BAD",
+                    identical ? "" : "  MISMATCH");
+    }
+    std::remove(path.c_str());
+}
+
+void benchEditSection(int maxCells) {
+    std::printf("Edit benchmark: setCell + query vs rebuildDerivedData vs regenerate\n");
+
+    const int edits = 200;
+    for (int cells = 64; cells <= maxCells; cells *= 2) {
+        Maze maze(cells, cells, GridLayout::ROW_MAJOR, 42);
+        Random rng(7);
+
+        // Toggle interior cells twice so the maze ends where it started
+        long long checksum = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < edits; ++i) {
+            int x = rng.uniformInt(1, maze.getGridWidth() - 2);
+            int y = rng.uniformInt(1, maze.getGridHeight() - 2);
+            std::uint8_t value = maze.isWall(x, y) ? CELL_EMPTY : CELL_WALL;
+            for (int pass = 0; pass < 2; ++pass) {
+                maze.setCell(x, y, value);
+                auto snapped = maze.snapToOpen(x, y);
+                checksum += snapped.first + snapped.second + maze.hasLineOfSight(x, 1, x, maze.getGridHeight() - 2);
+                value = value == CELL_WALL ? CELL_EMPTY : CELL_WALL;
+            }
+        }
+        double editMicros = secondsSince(start) / (edits * 2) * 1e6;
+
+        start = Clock::now();
+        maze.rebuildDerivedData();
+        double rebuildMicros = secondsSince(start) * 1e6;
+
+        start = Clock::now();
+        maze.regenerate(42);
+        double regenerateMicros = secondsSince(start) * 1e6;
+
+        std::printf("%5dx%-5d  edit+query %10.1f us  rebuild %10.1f us  regenerate %10.1f us  (x%.1f / x%.1f, checksum %lld)\n",
+                    cells, cells, editMicros, rebuildMicros, regenerateMicros, rebuildMicros / editMicros,
+                    regenerateMicros / editMicros, checksum);
+    }
+}
+
+/**
+ * @brief Times one kernel over many iterations; returns microseconds per call
+ */
+template <class Fn>
+double microsPerCall(int iterations, Fn&& fn) {
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    return secondsSince(start) / iterations * 1e6;
+}
+
+void benchKernelSection(int iterations) {
+    std::printf("Kernel benchmark: %dx%d grid, fixed-size vs runtime-sized vs Maze accessors\n",
+                DefaultGrid::width(), DefaultGrid::height());
+
+    Maze maze(DEFAULT_MAZE_WIDTH, DEFAULT_MAZE_HEIGHT, GridLayout::ROW_MAJOR, 42);
+    DefaultGrid fixed;
+    fixed.load(maze);
+    DynamicGrid dynamic;
+    dynamic.load(maze);
+
+    Random rng(3);
+    std::vector<std::pair<int, int>> targets;
+    for (int i = 0; i < 256; ++i) {
+        targets.push_back(maze.sampleByDistance(0, maze.getMaxStartDistance(), rng));
+    }
+
+    std::vector<int> field;
+    std::vector<int> parent;
+    std::vector<int> queue;
+    std::vector<std::uint8_t> masks;
+    long long checksum = 0;
+
+    // Distance field: the coarse-route BFS
+    double fieldFixed = microsPerCall(iterations, [&](int i) {
+        const auto& target = targets[i % targets.size()];
+        fillDistanceField(fixed, fixed.index(target.first, target.second), field, queue);
+        checksum += queue.size();
+    });
+    double fieldDynamic = microsPerCall(iterations, [&](int i) {
+        const auto& target = targets[i % targets.size()];
+        fillDistanceField(dynamic, dynamic.index(target.first, target.second), field, queue);
+        checksum += queue.size();
+    });
+    double fieldMaze = microsPerCall(iterations, [&](int i) {
+        const auto& target = targets[i % targets.size()];
+        const int gridWidth = maze.getGridWidth();
+        field.assign(gridWidth * maze.getGridHeight(), -1);
+        std::queue<std::pair<int, int>> frontier;
+        field[target.second * gridWidth + target.first] = 0;
+        frontier.push(target);
+        while (!frontier.empty()) {
+            auto [x, y] = frontier.front();
+            frontier.pop();
+            for (const auto& dir : DIRECTIONS) {
+                int nx = x + dir[0];
+                int ny = y + dir[1];
+                if (!maze.isWallUnchecked(nx, ny) && field[ny * gridWidth + nx] < 0) {
+                    field[ny * gridWidth + nx] = field[y * gridWidth + x] + 1;
+                    frontier.push({nx, ny});
+                }
+            }
+        }
+        checksum += field[0];
+    });
+    std::printf("distance field   fixed %8.2f us  dynamic %8.2f us  maze %8.2f us\n", fieldFixed, fieldDynamic,
+                fieldMaze);
+
+    // Shortest path between random open cells
+    Pathfinder pathfinder;
+    double pathFixed = microsPerCall(iterations, [&](int i) {
+        const auto& from = targets[i % targets.size()];
+        const auto& to = targets[(i * 7 + 1) % targets.size()];
+        checksum += findShortestPath(fixed, from.first, from.second, to.first, to.second, parent, queue).size();
+    });
+    double pathDynamic = microsPerCall(iterations, [&](int i) {
+        const auto& from = targets[i % targets.size()];
+        const auto& to = targets[(i * 7 + 1) % targets.size()];
+        checksum += findShortestPath(dynamic, from.first, from.second, to.first, to.second, parent, queue).size();
+    });
+    double pathAStar = microsPerCall(iterations, [&](int i) {
+        const auto& from = targets[i % targets.size()];
+        const auto& to = targets[(i * 7 + 1) % targets.size()];
+        checksum += pathfinder.findPath(from.first, from.second, to.first, to.second, maze).size();
+    });
+    std::printf("shortest path    fixed %8.2f us  dynamic %8.2f us  A* on maze %8.2f us\n", pathFixed, pathDynamic,
+                pathAStar);
+
+    // Wall-line masks: the CPU side of Maze::drawWallLines
+    double masksFixed = microsPerCall(iterations, [&](int) {
+        buildWallMasks(fixed, masks);
+        checksum += masks[1];
+    });
+    double masksDynamic = microsPerCall(iterations, [&](int) {
+        buildWallMasks(dynamic, masks);
+        checksum += masks[1];
+    });
+    double masksMaze = microsPerCall(iterations, [&](int) {
+        const int width = maze.getGridWidth();
+        const int height = maze.getGridHeight();
+        masks.assign(width * height, 0);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (!maze.isWallUnchecked(x, y)) continue;
+                masks[y * width + x] = WALL_MASK_SELF |
+                                       (y > 0 && maze.isWallUnchecked(x, y - 1) ? WALL_MASK_ABOVE : 0) |
+                                       (x < width - 1 && maze.isWallUnchecked(x + 1, y) ? WALL_MASK_RIGHT : 0) |
+                                       (y < height - 1 && maze.isWallUnchecked(x, y + 1) ? WALL_MASK_BELOW : 0) |
+                                       (x > 0 && maze.isWallUnchecked(x - 1, y) ? WALL_MASK_LEFT : 0);
+            }
+        }
+        checksum += masks[1];
+    });
+    std::printf("wall masks       fixed %8.2f us  dynamic %8.2f us  maze %8.2f us  (checksum %lld)\n", masksFixed,
+                masksDynamic, masksMaze, checksum);
+}
+
+void benchShareSection(int matchCount) {
+    std::printf("Share benchmark: %d match copies of one seeded maze\n", matchCount);
+
+    for (int cells : {DEFAULT_MAZE_WIDTH, 128, 512}) {
+        Maze shared(cells, cells, GridLayout::ROW_MAJOR, 42);
+
+        auto start = Clock::now();
+        std::vector<Maze> matches(matchCount, shared);
+        double copyMicros = secondsSince(start) / matchCount * 1e6;
+
+        // The first edit on a copy clones the cells and the pages it touches; later edits don't
+        start = Clock::now();
+        matches[0].setCell(1, 1, matches[0].isWall(1, 1) ? CELL_EMPTY : CELL_WALL);
+        double firstEditMicros = secondsSince(start) * 1e6;
+        size_t editedBytes = matches[0].getOwnedLayoutMemoryBytes();
+        start = Clock::now();
+        matches[0].setCell(1, 1, matches[0].isWall(1, 1) ? CELL_EMPTY : CELL_WALL);
+        double nextEditMicros = secondsSince(start) * 1e6;
+
+        std::printf("%4dx%-4d  layout %9zu B once  per match %4zu B  copy %6.3f us  first edit %9.1f us (%8zu B)  next edit %7.1f us  (%ld sharing)\n",
+                    cells, cells, shared.getLayoutMemoryBytes(), matches[1].getHandleMemoryBytes(), copyMicros,
+                    firstEditMicros, editedBytes, nextEditMicros, shared.getShareCount());
+    }
+}
+
+void benchAlgorithmSection(int maxCells) {
+    std::printf("Algorithm benchmark: carve throughput and peak scratch memory per generator\n");
+
+    std::vector<int> sizes;
+    for (int cells = 1024; cells <= maxCells; cells *= 4) {
+        sizes.push_back(cells);
+    }
+    if (sizes.empty() || sizes.back() != maxCells) {
+        sizes.push_back(maxCells);
+    }
+
+    for (int cells : sizes) {
+        int side = cells * 2 + 1;
+        double logicalCells = static_cast<double>(cells) * cells;
+        for (const auto& generator : Maze::getGenerators()) {
+            GridStorage grid(side, side);
+            grid.fill(CELL_WALL);
+            Random rng(42);
+
+            // Peak is measured above what is live before carving (the grid itself)
+            size_t baseline = g_liveBytes.load();
+            g_peakBytes.store(baseline);
+            auto start = Clock::now();
+            generator.carve(grid, rng);
+            double seconds = secondsSince(start);
+            double scratchMB = static_cast<double>(g_peakBytes.load() - baseline) / (1024.0 * 1024.0);
+
+            std::printf("%5dx%-5d  %-8s %8.3f s (%7.2f Mcells/s)  grid %8.1f MB  peak scratch %8.1f MB (%5.2f B/cell)\n",
+                        cells, cells, generator.name, seconds, logicalCells / seconds / 1e6,
+                        grid.size() / (1024.0 * 1024.0), scratchMB, scratchMB * 1024.0 * 1024.0 / logicalCells);
+        }
+    }
+}
+
+/**
+ * @brief Byte-per-cell reference for stepLifeLike with set cells outside
+ *
+ * Both grids have a one-cell border of 1s, so the neighbor sum needs no
+ * bounds checks.
+ */
+void stepLifeLikeScalar(const std::vector<std::uint8_t>& source, std::vector<std::uint8_t>& target, int width,
+                        int height, std::uint16_t birthMask, std::uint16_t surviveMask) {
+    const int stride = width + 2;
+    for (int y = 1; y <= height; ++y) {
+        for (int x = 1; x <= width; ++x) {
+            int index = y * stride + x;
+            int count = source[index - stride - 1] + source[index - stride] + source[index - stride + 1] +
+                        source[index - 1] + source[index + 1] + source[index + stride - 1] + source[index + stride] +
+                        source[index + stride + 1];
+            std::uint16_t rule = source[index] ? surviveMask : birthMask;
+            target[index] = (rule >> count) & 1;
+        }
+    }
+}
+
+void benchCaveSection(int maxSide) {
+    std::printf("Cave benchmark: %d automaton generations, bit-sliced vs scalar\n", CAVE_SMOOTHING_STEPS);
+
+    std::vector<int> sides;
+    for (int side = 1024; side <= maxSide; side *= 2) {
+        sides.push_back(side);
+    }
+    if (sides.empty() || sides.back() != maxSide) {
+        sides.push_back(maxSide);
+    }
+
+    for (int side : sides) {
+        Random rng(42);
+        BitGrid bits(side, side);
+        std::vector<std::uint8_t> bytes((side + 2) * (side + 2), 1);
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                bool wall = rng.chance(CAVE_WALL_PERCENT);
+                bits.set(x, y, wall);
+                bytes[(y + 1) * (side + 2) + x + 1] = wall;
+            }
+        }
+
+        BitGrid nextBits;
+        auto start = Clock::now();
+        for (int step = 0; step < CAVE_SMOOTHING_STEPS; ++step) {
+            stepLifeLike(bits, nextBits, CAVE_BIRTH_MASK, CAVE_SURVIVE_MASK, true);
+            std::swap(bits, nextBits);
+        }
+        double bitSeconds = secondsSince(start);
+
+        std::vector<std::uint8_t> nextBytes = bytes;
+        start = Clock::now();
+        for (int step = 0; step < CAVE_SMOOTHING_STEPS; ++step) {
+            stepLifeLikeScalar(bytes, nextBytes, side, side, CAVE_BIRTH_MASK, CAVE_SURVIVE_MASK);
+            std::swap(bytes, nextBytes);
+        }
+        double scalarSeconds = secondsSince(start);
+
+        long mismatches = 0;
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                mismatches += bits.get(x, y) != (bytes[(y + 1) * (side + 2) + x + 1] != 0);
+            }
+        }
+
+        GridStorage grid(side | 1, side | 1);
+        start = Clock::now();
+        Maze::carveCaves(grid, rng);
+        double carveSeconds = secondsSince(start);
+
+        double cellSteps = static_cast<double>(side) * side * CAVE_SMOOTHING_STEPS;
+        std::printf("%5dx%-5d  bits %8.4f s (%8.1f Mcells/s)  scalar %8.4f s (%7.1f Mcells/s)  %5.1fx  carve %7.3f s%s\n",
+                    side, side, bitSeconds, cellSteps / bitSeconds / 1e6, scalarSeconds,
+                    cellSteps / scalarSeconds / 1e6, scalarSeconds / bitSeconds, carveSeconds,
+                    mismatches ? "  MISMATCH" : "");
+    }
+}
+
+void benchImageSection(int side) {
+    std::printf("Image benchmark: %dx%d RGBA import (decode excluded)\n", side, side);
+
+    for (int cellPixels : {1, 4, 16}) {
+        const int gridSide = side / cellPixels;
+        if (gridSide < 3) {
+            continue;
+        }
+
+        // Pillared grid with random walls, a closed border and one exit at (1, 0)
+        Random rng(42);
+        std::vector<std::uint8_t> walls(static_cast<size_t>(gridSide) * gridSide);
+        for (int y = 0; y < gridSide; ++y) {
+            for (int x = 0; x < gridSide; ++x) {
+                bool border = x == 0 || y == 0 || x == gridSide - 1 || y == gridSide - 1;
+                walls[y * gridSide + x] = border || (x % 2 == 0 && y % 2 == 0) || rng.chance(RANDOM_WALL_PERCENT);
+            }
+        }
+        walls[1] = 0;
+        walls[gridSide + 1] = 0;
+
+        // Grey-level ink so the threshold has work to do
+        std::vector<std::uint8_t> pixels(static_cast<size_t>(side) * side * 4, 255);
+        for (int y = 0; y < gridSide * cellPixels; ++y) {
+            std::uint8_t* row = pixels.data() + static_cast<size_t>(y) * side * 4;
+            for (int x = 0; x < gridSide * cellPixels; ++x) {
+                std::uint8_t level = walls[(y / cellPixels) * gridSide + x / cellPixels] ? 40 : 220;
+                row[x * 4] = level;
+                row[x * 4 + 1] = level;
+                row[x * 4 + 2] = level;
+            }
+        }
+
+        MazeImage image;
+        auto start = Clock::now();
+        MazeImage::Status status = image.loadPixels(pixels.data(), side, side, cellPixels);
+        double seconds = secondsSince(start);
+
+        long mismatches = 0;
+        for (int y = 0; y < gridSide && status == MazeImage::Status::OK; ++y) {
+            for (int x = 0; x < gridSide; ++x) {
+                mismatches += image.isWall(x, y) != (walls[y * gridSide + x] != 0);
+            }
+        }
+
+        start = Clock::now();
+        Maze maze(image);
+        double mazeSeconds = secondsSince(start);
+
+        double megapixels = static_cast<double>(side) * side / 1e6;
+        std::printf("%2d px/cell  grid %5dx%-5d  import %7.3f s (%7.0f Mpixels/s, %5.2f GB/s)  Maze %7.3f s  %s%s\n",
+                    cellPixels, gridSide, gridSide, seconds, megapixels / seconds, megapixels * 4 / 1e3 / seconds,
+                    mazeSeconds, MazeImage::describe(status), mismatches ? "  MISMATCH" : "");
+    }
+}
+
+void benchExternalSection(int cells) {
+    std::printf("External benchmark: out-of-core distance field over a %dx%d Eller maze\n", cells, cells);
+
+    const std::string mazePath = "MazeBench.maze";
+    const std::string distancePath = "MazeBench.dist";  // Plus the run index
+    auto start = Clock::now();
+    if (!MazeFile::writeEller(mazePath, cells, cells, 42)) {
+        std::printf("Could not write %s\n", mazePath.c_str());
+        return;
+    }
+    double writeSeconds = secondsSince(start);
+
+    MazeFile file;
+    if (!file.open(mazePath)) {
+        std::printf("Could not map %s\n", mazePath.c_str());
+        return;
+    }
+    const int gridWidth = file.getGridWidth();
+    const int gridHeight = file.getGridHeight();
+    std::printf("write %.3f s (%.1f MB of rows)\n", writeSeconds,
+                static_cast<double>(file.getRowBytes()) * gridHeight / 1e6);
+
+    // External runs first, so the peak resident size is not inflated by the reference below
+    const int tileSizes[] = {256, EXTERNAL_TILE_CELLS};
+    Pathfinder::ExternalStats stats[2];
+    bool built[2];
+    for (int i = 0; i < 2; ++i) {
+        built[i] = Pathfinder::buildExternalDistanceField(file, 1, 1, distancePath + std::to_string(i), stats[i],
+                                                          tileSizes[i]);
+    }
+
+    // Reference: plain in-memory BFS from the same target
+    std::vector<std::uint32_t> reference(static_cast<size_t>(gridWidth) * gridHeight, MazeFile::UNREACHABLE);
+    std::vector<int> queue;
+    reference[gridWidth + 1] = 0;
+    queue.push_back(gridWidth + 1);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int index = queue[head];
+        int x = index % gridWidth;
+        int y = index / gridWidth;
+        auto visit = [&](int newX, int newY) {
+            if (newX >= 0 && newY >= 0 && newX < gridWidth && newY < gridHeight && !file.isWall(newX, newY) &&
+                reference[newY * gridWidth + newX] == MazeFile::UNREACHABLE) {
+                reference[newY * gridWidth + newX] = reference[index] + 1;
+                queue.push_back(newY * gridWidth + newX);
+            }
+        };
+        visit(x, y - 1);
+        visit(x, y + 1);
+        visit(x - 1, y);
+        visit(x + 1, y);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        const int tileCells = tileSizes[i];
+        const std::string path = distancePath + std::to_string(i);
+        if (!built[i]) {
+            std::printf("tile %4d  FAILED\n", tileCells);
+            continue;
+        }
+
+        // Compare a tile block at a time, in file order
+        long mismatches = 0;
+        const int tilesX = (gridWidth + tileCells - 1) / tileCells;
+        const int tilesY = (gridHeight + tileCells - 1) / tileCells;
+        std::vector<std::uint32_t> block(static_cast<size_t>(tileCells) * tileCells);
+        std::FILE* distances = std::fopen(path.c_str(), "rb");
+        for (int tile = 0; distances && tile < tilesX * tilesY; ++tile) {
+            if (std::fread(block.data(), sizeof(std::uint32_t), block.size(), distances) != block.size()) {
+                mismatches++;
+                break;
+            }
+            const int originX = tile % tilesX * tileCells;
+            const int originY = tile / tilesX * tileCells;
+            for (int y = originY; y < std::min(gridHeight, originY + tileCells); ++y) {
+                for (int x = originX; x < std::min(gridWidth, originX + tileCells); ++x) {
+                    mismatches += block[(y - originY) * tileCells + x - originX] != reference[y * gridWidth + x];
+                }
+            }
+        }
+        if (distances) {
+            std::fclose(distances);
+        }
+        std::remove(path.c_str());
+
+        std::printf("tile %4d  %7.3f s  %3d sweeps  %6llu tiles  read %8.1f MB  written %8.1f MB  peak RSS %7.1f MB"
+                    "  reached %llu/%llu  max %u%s\n",
+                    tileCells, stats[i].seconds, stats[i].sweeps,
+                    static_cast<unsigned long long>(stats[i].tilesProcessed), stats[i].bytesRead / 1e6,
+                    stats[i].bytesWritten / 1e6, stats[i].peakResidentBytes / 1e6,
+                    static_cast<unsigned long long>(stats[i].reachedCells),
+                    static_cast<unsigned long long>(stats[i].openCells), stats[i].maxDistance,
+                    mismatches ? "  MISMATCH" : "");
+    }
+
+    file.close();
+    std::remove(mazePath.c_str());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string section = argc > 1 ? argv[1] : "all";
+    int max = argc > 2 ? std::atoi(argv[2]) : 0;
+
+    if (section == "all" || section == "layout") {
+        benchLayoutSection(max > 0 ? max : 4096);
+    }
+    if (section == "all" || section == "generate") {
+        benchGenerateSection(max > 0 ? max : 8192);
+    }
+    if (section == "all" || section == "eller") {
+        benchEllerSection(max > 0 ? max : 1024);
+    }
+    if (section == "all" || section == "file") {
+        benchFileSection(max > 0 ? max : 4096);
+    }
+    if (section == "all" || section == "edit") {
+        benchEditSection(max > 0 ? max : 1024);
+    }
+    if (section == "all" || section == "kernel") {
+        benchKernelSection(max > 0 ? max : 20000);
+    }
+    if (section == "all" || section == "share") {
+        benchShareSection(max > 0 ? max : 1000);
+    }
+    if (section == "all" || section == "algorithms") {
+        benchAlgorithmSection(max > 0 ? max : 4096);
+    }
+    if (section == "all" || section == "caves") {
+        benchCaveSection(max > 0 ? max : 4096);
+    }
+    if (section == "all" || section == "image") {
+        benchImageSection(max > 0 ? max : 8192);
+    }
+    if (section == "all" || section == "external") {
+        benchExternalSection(max > 0 ? max : 4096);
+    }
+    return 0;
+}
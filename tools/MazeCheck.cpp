@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Maze.h"
+#include "Random.h"
+
+/**
+ * @file MazeCheck.cpp
+ * @brief Self-checks for maze generation and the derived tables
+ *
+ * Usage: MazeCheck [section]
+ *
+ * Sections (all run when none is given):
+ * - chokepoints: articulation cells, bridges, components and chokepoints
+ *   on a hand-built grid
+ * - transform: the incremental distance transform after random edits,
+ *   against a full rebuild
+ * - eller: Eller's algorithm output is a perfect maze
+ * - exits: every perfect generator opens exactly two exits, for odd and
+ *   even maze sizes
+ * - share: edits through a copy leave the shared maze untouched, and the
+ *   copy's tables match a full rebuild
+ *
+ * Prints every failed check and exits with status 1 if there was any;
+ * registered with CTest.
+ */
+
+namespace {
+
+int g_failures = 0;
+
+/**
+ * @brief Records a check, printing it if it failed
+ */
+void check(bool passed, const char* format, ...) {
+    if (passed) {
+        return;
+    }
+    g_failures++;
+    std::printf("FAILED: ");
+    va_list args;
+    va_start(args, format);
+    std::vprintf(format, args);
+    va_end(args);
+    std::printf("\n");
+}
+
+/**
+ * @brief Replaces a maze's cells with a picture ('#' = wall, anything else = open)
+ *
+ * @param maze Maze whose grid is exactly the picture's size
+ * @param picture One string per grid row
+ */
+void drawMaze(Maze& maze, const std::vector<std::string>& picture) {
+    std::vector<Maze::CellEdit> edits;
+    for (int y = 0; y < static_cast<int>(picture.size()); ++y) {
+        for (int x = 0; x < static_cast<int>(picture[y].size()); ++x) {
+            std::uint8_t value = picture[y][x] == '#' ? CELL_WALL : CELL_EMPTY;
+            edits.push_back({x, y, value});
+        }
+    }
+    maze.applyEdits(edits);
+}
+
+void checkChokepoints() {
+    std::printf("chokepoints\n");
+
+    // Two loops joined by a corridor, with a dead-end spur off the corridor
+    const std::vector<std::string> picture = {
+        "###########",
+        "#...#.#...#",
+        "#.#.#.#.#.#",
+        "#.........#",
+        "###########",
+    };
+    Maze maze(5, 2);
+    drawMaze(maze, picture);
+
+    const std::vector<std::pair<int, int>> articulations = {{3, 3}, {4, 3}, {5, 3}, {6, 3}, {7, 3}, {5, 2}};
+    for (int y = 0; y < maze.getGridHeight(); ++y) {
+        for (int x = 0; x < maze.getGridWidth(); ++x) {
+            bool expected = std::find(articulations.begin(), articulations.end(), std::make_pair(x, y)) !=
+                            articulations.end();
+            check(maze.isArticulation(x, y) == expected, "isArticulation(%d, %d) should be %d", x, y, expected);
+        }
+    }
+
+    // Corridor and spur passages are bridges; loop passages are not
+    const int bridges[][4] = {{3, 3, 4, 3}, {4, 3, 5, 3}, {5, 3, 6, 3}, {6, 3, 7, 3}, {5, 3, 5, 2}, {5, 2, 5, 1}};
+    for (const auto& bridge : bridges) {
+        check(maze.isBridge(bridge[0], bridge[1], bridge[2], bridge[3]) &&
+                  maze.isBridge(bridge[2], bridge[3], bridge[0], bridge[1]),
+              "(%d, %d)-(%d, %d) should be a bridge", bridge[0], bridge[1], bridge[2], bridge[3]);
+    }
+    check(!maze.isBridge(1, 1, 2, 1), "(1, 1)-(2, 1) is on a loop, not a bridge");
+    check(!maze.isBridge(1, 1, 1, 3), "cells that aren't adjacent are never a bridge");
+
+    // Two loops plus one component per bridge
+    check(maze.getBiconnectedComponentCount() == 8, "expected 8 biconnected components, got %d",
+          maze.getBiconnectedComponentCount());
+    check(maze.getBiconnectedComponent(1, 1) == maze.getBiconnectedComponent(3, 1), "left loop is one component");
+    check(maze.getBiconnectedComponent(1, 1) != maze.getBiconnectedComponent(9, 1), "the loops are different components");
+    check(maze.getBiconnectedComponent(0, 0) == -1, "walls have no component");
+
+    std::vector<std::pair<int, int>> cells;
+    const std::vector<std::pair<int, int>> across = {{3, 3}, {4, 3}, {5, 3}, {6, 3}, {7, 3}};
+    check(maze.getChokepoints(1, 1, 9, 1, cells) && cells == across, "chokepoints between the loops");
+    std::vector<std::pair<int, int>> back(across.rbegin(), across.rend());
+    check(maze.getChokepoints(9, 1, 1, 1, cells) && cells == back, "chokepoints are ordered from the source");
+    const std::vector<std::pair<int, int>> toSpur = {{3, 3}, {4, 3}, {5, 3}, {5, 2}};
+    check(maze.getChokepoints(1, 1, 5, 1, cells) && cells == toSpur, "chokepoints into the spur");
+    check(maze.getChokepoints(1, 1, 3, 1, cells) && cells.empty(), "no chokepoints inside one loop");
+    check(maze.getChokepoints(3, 3, 7, 3, cells) && cells.size() == 3, "endpoints are not chokepoints");
+    check(!maze.getChokepoints(1, 1, 0, 0, cells), "no route to a wall");
+
+    // Walling the corridor off splits the maze: the analysis follows the edit
+    maze.setCell(5, 3, CELL_WALL);
+    check(!maze.getChokepoints(1, 1, 9, 1, cells), "no route across a walled corridor");
+    check(!maze.isArticulation(5, 3) && !maze.isArticulation(4, 3), "corridor ends become dead ends");
+}
+
+void checkDistanceTransform() {
+    std::printf("transform\n");
+
+    Random rng(7);
+    for (int round = 0; round < 20; ++round) {
+        Maze edited(12, 9, GridLayout::ROW_MAJOR, 100 + round);
+        const int gridWidth = edited.getGridWidth();
+        const int gridHeight = edited.getGridHeight();
+
+        // Batches of random edits, each repaired incrementally
+        for (int batch = 0; batch < 5; ++batch) {
+            std::vector<Maze::CellEdit> edits;
+            int count = rng.uniformInt(1, 12);
+            for (int i = 0; i < count; ++i) {
+                std::uint8_t value = rng.chance(60) ? CELL_WALL : CELL_EMPTY;
+                edits.push_back({rng.uniformInt(0, gridWidth - 1), rng.uniformInt(0, gridHeight - 1), value});
+            }
+            edited.applyEdits(edits);
+        }
+
+        // A copy rebuilt from scratch must agree on every cell
+        Maze rebuilt(edited);
+        rebuilt.rebuildDerivedData();
+        int mismatches = 0;
+        for (int y = 0; y < gridHeight; ++y) {
+            for (int x = 0; x < gridWidth; ++x) {
+                int distance = edited.getDistanceToOpen(x, y);
+                auto nearest = edited.snapToOpen(x, y);
+                bool nearestOk = !edited.isWall(nearest.first, nearest.second) &&
+                                 std::abs(nearest.first - x) + std::abs(nearest.second - y) == distance;
+                mismatches += distance != rebuilt.getDistanceToOpen(x, y) || !nearestOk;
+            }
+        }
+        check(mismatches == 0, "round %d: %d cells differ from a full rebuild", round, mismatches);
+    }
+}
+
+void checkEller() {
+    std::printf("eller\n");
+
+    for (int seed = 1; seed <= 20; ++seed) {
+        Maze maze(5 + seed % 7, 4 + seed % 5);
+        maze.regenerateEller(seed);
+        const int gridWidth = maze.getGridWidth();
+        const int gridHeight = maze.getGridHeight();
+
+        // A perfect maze is a tree: connected, with one passage fewer than open cells
+        int openCells = 0;
+        int passages = 0;
+        for (int y = 0; y < gridHeight; ++y) {
+            for (int x = 0; x < gridWidth; ++x) {
+                if (maze.isWall(x, y)) {
+                    continue;
+                }
+                openCells++;
+                passages += !maze.isWall(x + 1, y) + !maze.isWall(x, y + 1);
+            }
+        }
+        int reachable = maze.countByDistance(0, maze.getMaxStartDistance());
+        check(reachable == openCells, "seed %d: %d of %d open cells reachable", seed, reachable, openCells);
+        check(passages == openCells - 1, "seed %d: %d passages for %d open cells", seed, passages, openCells);
+        check(maze.getExits().size() == 2, "seed %d: %zu exits", seed, maze.getExits().size());
+    }
+}
+
+void checkExits() {
+    std::printf("exits\n");
+
+    const int sizes[][2] = {{9, 5}, {10, 6}, {8, 8}, {24, 24}, {21, 21}, {6, 11}};
+    for (const auto& generator : Maze::getGenerators()) {
+        if (!generator.perfect) {
+            continue;
+        }
+        for (const auto& size : sizes) {
+            Maze maze(size[0], size[1], GridLayout::ROW_MAJOR, 42, generator.algorithm);
+
+            // Open border cells, counted straight from the grid
+            int borderOpen = 0;
+            for (int y = 0; y < maze.getGridHeight(); ++y) {
+                for (int x = 0; x < maze.getGridWidth(); ++x) {
+                    bool onBorder = x == 0 || y == 0 || x == maze.getGridWidth() - 1 || y == maze.getGridHeight() - 1;
+                    borderOpen += onBorder && !maze.isWall(x, y);
+                }
+            }
+            check(borderOpen == 2 && maze.getExits().size() == 2, "%s %dx%d: %d open border cells, %zu exits",
+                  generator.name, size[0], size[1], borderOpen, maze.getExits().size());
+        }
+    }
+}
+
+void checkShare() {
+    std::printf("share\n");
+
+    Random rng(11);
+    for (int round = 0; round < 10; ++round) {
+        const Maze original(30, 20, GridLayout::ROW_MAJOR, 300 + round);
+        const Maze reference(30, 20, GridLayout::ROW_MAJOR, 300 + round);  // Same maze, never shared
+        const int gridWidth = original.getGridWidth();
+        const int gridHeight = original.getGridHeight();
+        const int originalStart = original.getStartDistance(original.getStart().first, original.getStart().second);
+
+        // One edit costs the cells and the few table pages it changed, not the whole layout
+        Maze shared(original);
+        Maze edited(original);
+        const int editX = rng.uniformInt(1, gridWidth - 2);
+        const int editY = rng.uniformInt(1, gridHeight - 2);
+        edited.setCell(editX, editY, original.isWall(editX, editY) ? CELL_EMPTY : CELL_WALL);
+        check(edited.getOwnedLayoutMemoryBytes() < original.getLayoutMemoryBytes() / 4,
+              "round %d: first edit took %zu of %zu layout bytes", round, edited.getOwnedLayoutMemoryBytes(),
+              original.getLayoutMemoryBytes());
+
+        std::vector<Maze::CellEdit> edits;
+        for (int i = 0; i < 8; ++i) {
+            std::uint8_t value = rng.chance(50) ? CELL_WALL : CELL_EMPTY;
+            edits.push_back({rng.uniformInt(0, gridWidth - 1), rng.uniformInt(0, gridHeight - 1), value});
+        }
+        edited.applyEdits(edits);
+
+        Maze rebuilt(edited);
+        rebuilt.rebuildDerivedData();
+        int leaked = 0;
+        int mismatches = 0;
+        for (int y = 0; y < gridHeight; ++y) {
+            for (int x = 0; x < gridWidth; ++x) {
+                leaked += shared.isWall(x, y) != reference.isWall(x, y) ||
+                          shared.getDistanceToOpen(x, y) != reference.getDistanceToOpen(x, y) ||
+                          shared.hasLineOfSight(x, y, gridWidth / 2, y) != reference.hasLineOfSight(x, y, gridWidth / 2, y);
+                mismatches += edited.getDistanceToOpen(x, y) != rebuilt.getDistanceToOpen(x, y) ||
+                              edited.hasLineOfSight(x, y, gridWidth / 2, y) != rebuilt.hasLineOfSight(x, y, gridWidth / 2, y) ||
+                              edited.hasLineOfSight(x, y, x, gridHeight / 2) != rebuilt.hasLineOfSight(x, y, x, gridHeight / 2) ||
+                              edited.getStartDistance(x, y) != rebuilt.getStartDistance(x, y);
+            }
+        }
+        check(leaked == 0, "round %d: %d cells of the shared maze changed", round, leaked);
+        check(mismatches == 0, "round %d: %d cells of the edited copy differ from a full rebuild", round, mismatches);
+        check(shared.getStartDistance(shared.getStart().first, shared.getStart().second) == originalStart &&
+                  shared.getVersion() == original.getVersion() && edited.getVersion() != original.getVersion(),
+              "round %d: versions and analysis stay per copy", round);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string section = argc > 1 ? argv[1] : "all";
+
+    if (section == "all" || section == "chokepoints") {
+        checkChokepoints();
+    }
+    if (section == "all" || section == "transform") {
+        checkDistanceTransform();
+    }
+    if (section == "all" || section == "eller") {
+        checkEller();
+    }
+    if (section == "all" || section == "exits") {
+        checkExits();
+    }
+    if (section == "all" || section == "share") {
+        checkShare();
+    }
+
+    std::printf(g_failures == 0 ? "All checks passed\n" : "%d checks failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,411 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Maze.h"
+
+/**
+ * @file MazeCorpus.cpp
+ * @brief Generates seeded mazes on every core and writes per-maze metrics
+ *
+ * Usage: MazeCorpus [count] [options]
+ *
+ * Options:
+ * - --size N: logical cells per side (default 21, a 43x43 grid)
+ * - --seed S: seed of the first maze; maze i uses S + i (default 1)
+ * - --threads T: worker threads (default: all cores)
+ * - --generator dfs|kruskal|prim|wilson|caves|eller|walls: Maze generator (default dfs)
+ * - --format csv|bin: output format (default csv)
+ * - --out PATH: output file (default corpus.csv / corpus.bin)
+ *
+ * Rows are written in seed order, so a corpus is reproducible for any
+ * thread count. The binary format is a CorpusHeader followed by count
+ * MazeMetrics records in host byte order.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int DIRECTIONS[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+const int SEEDS_PER_BATCH = 1024;  // Mazes per unit of work (and per output write)
+
+enum class Generator { DFS, ELLER, WALLS, KRUSKAL, PRIM, WILSON, CAVES };
+
+/**
+ * @brief Metrics of one maze (also the binary record)
+ */
+struct MazeMetrics {
+    std::uint64_t seed;          ///< Generation seed
+    std::uint32_t openCells;     ///< Open grid cells
+    std::uint32_t deadEnds;      ///< Open cells with one open neighbor
+    std::uint32_t junctions;     ///< Open cells with three or more open neighbors
+    std::uint32_t exits;         ///< Open border cells
+    float meanCorridorLength;    ///< Mean steps between junctions, dead ends and exits
+    float branchingFactor;       ///< Mean new directions offered per junction
+    std::int32_t centerToExit;   ///< Steps from the center start to the nearest exit (-1 = none)
+    std::int32_t solutionLength; ///< Steps between the two closest exits (-1 = fewer than two)
+};
+
+static_assert(sizeof(MazeMetrics) == 40, "MazeMetrics must have a fixed layout");
+
+/**
+ * @brief Header of a binary corpus file
+ */
+struct CorpusHeader {
+    char magic[8];               ///< "OUBCORP\0"
+    std::uint32_t version;       ///< Format version (1)
+    std::uint32_t byteOrderMark; ///< 0x01020304 as written by the host
+    std::uint32_t recordSize;    ///< sizeof(MazeMetrics)
+    std::uint32_t generator;     ///< Generator enum value
+    std::uint32_t gridWidth;     ///< Grid width of every maze
+    std::uint32_t gridHeight;    ///< Grid height of every maze
+    std::uint64_t firstSeed;     ///< Seed of record 0
+    std::uint64_t count;         ///< Number of records
+};
+
+static_assert(sizeof(CorpusHeader) == 48, "CorpusHeader must have a fixed layout");
+
+/**
+ * @brief Options parsed from the command line
+ */
+struct Options {
+    std::uint64_t count = 100000;
+    int size = DEFAULT_MAZE_WIDTH;
+    std::uint64_t firstSeed = 1;
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    Generator generator = Generator::DFS;
+    bool binary = false;
+    std::string out;
+};
+
+/**
+ * @brief Per-thread maze and BFS buffers, reused for every maze
+ */
+struct Worker {
+    explicit Worker(int size) : maze(size, size, GridLayout::ROW_MAJOR, 0) {}
+
+    Maze maze;
+    std::vector<int> distance;
+    std::vector<int> queue;
+};
+
+void generate(Worker& worker, Generator generator, std::uint64_t seed) {
+    switch (generator) {
+        case Generator::ELLER:
+            worker.maze.regenerateEller(seed);
+            break;
+        case Generator::WALLS:
+            worker.maze.regenerateRandomWalls(seed);
+            break;
+        case Generator::KRUSKAL:
+            worker.maze.regenerate(seed, MazeAlgorithm::KRUSKAL);
+            break;
+        case Generator::PRIM:
+            worker.maze.regenerate(seed, MazeAlgorithm::PRIM);
+            break;
+        case Generator::WILSON:
+            worker.maze.regenerate(seed, MazeAlgorithm::WILSON);
+            break;
+        case Generator::CAVES:
+            worker.maze.regenerate(seed, MazeAlgorithm::CAVES);
+            break;
+        case Generator::DFS:
+        default:
+            worker.maze.regenerate(seed);
+            break;
+    }
+}
+
+/**
+ * @brief Computes the metrics of the worker's current maze
+ *
+ * Cell kinds and the center distances come from the maze's analysis pass;
+ * the exit-to-exit distance needs one extra BFS from the first exit.
+ */
+MazeMetrics analyze(Worker& worker, std::uint64_t seed) {
+    const Maze& maze = worker.maze;
+    const int gridWidth = maze.getGridWidth();
+    const int gridHeight = maze.getGridHeight();
+
+    MazeMetrics metrics = {};
+    metrics.seed = seed;
+    metrics.centerToExit = -1;
+    metrics.solutionLength = -1;
+
+    std::uint32_t corridorCells = 0;
+    std::uint32_t nodeDegrees = 0;
+    std::uint32_t junctionBranches = 0;
+    int firstExit = -1;
+
+    for (int y = 0; y < gridHeight; ++y) {
+        for (int x = 0; x < gridWidth; ++x) {
+            CellKind kind = maze.getCellKind(x, y);
+            if (kind == CellKind::WALL) {
+                continue;
+            }
+            metrics.openCells++;
+            if (kind == CellKind::CORRIDOR) {
+                corridorCells++;
+                continue;
+            }
+
+            int openNeighbors = 0;
+            for (const auto& dir : DIRECTIONS) {
+                openNeighbors += !maze.isWallUnchecked(x + dir[0], y + dir[1]);
+            }
+            nodeDegrees += openNeighbors;
+
+            if (kind == CellKind::DEAD_END) {
+                metrics.deadEnds++;
+            } else if (kind == CellKind::JUNCTION) {
+                metrics.junctions++;
+                junctionBranches += openNeighbors - 1;
+            } else if (kind == CellKind::EXIT) {
+                metrics.exits++;
+                if (firstExit < 0) firstExit = y * gridWidth + x;
+                int distance = maze.getStartDistance(x, y);
+                if (distance >= 0 && (metrics.centerToExit < 0 || distance < metrics.centerToExit)) {
+                    metrics.centerToExit = distance;
+                }
+            }
+        }
+    }
+
+    // Every corridor cell lies on exactly one segment between two nodes, and a
+    // segment of k corridor cells is k + 1 steps long
+    std::uint32_t segments = nodeDegrees / 2;
+    if (segments > 0) {
+        metrics.meanCorridorLength = static_cast<float>(corridorCells + segments) / segments;
+    }
+    if (metrics.junctions > 0) {
+        metrics.branchingFactor = static_cast<float>(junctionBranches) / metrics.junctions;
+    }
+
+    if (metrics.exits < 2) {
+        return metrics;
+    }
+
+    // Solution: shortest walk from the first exit to any other exit
+    std::vector<int>& distance = worker.distance;
+    std::vector<int>& queue = worker.queue;
+    distance.assign(gridWidth * gridHeight, -1);
+    queue.clear();
+    distance[firstExit] = 0;
+    queue.push_back(firstExit);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int index = queue[head];
+        int x = index % gridWidth;
+        int y = index / gridWidth;
+        if (index != firstExit && maze.getCellKind(x, y) == CellKind::EXIT) {
+            metrics.solutionLength = distance[index];
+            break;
+        }
+        for (const auto& dir : DIRECTIONS) {
+            int newX = x + dir[0];
+            int newY = y + dir[1];
+            if (maze.isWallUnchecked(newX, newY)) {
+                continue;
+            }
+            int newIndex = newY * gridWidth + newX;
+            if (distance[newIndex] < 0) {
+                distance[newIndex] = distance[index] + 1;
+                queue.push_back(newIndex);
+            }
+        }
+    }
+
+    return metrics;
+}
+
+void appendCsvRow(std::string& out, const MazeMetrics& metrics) {
+    char line[160];
+    int length = std::snprintf(line, sizeof(line), "%llu,%u,%u,%u,%u,%.3f,%.3f,%d,%d\n",
+                               static_cast<unsigned long long>(metrics.seed), metrics.openCells, metrics.deadEnds,
+                               metrics.junctions, metrics.exits, metrics.meanCorridorLength, metrics.branchingFactor,
+                               metrics.centerToExit, metrics.solutionLength);
+    out.append(line, length);
+}
+
+bool parseGenerator(const std::string& name, Generator& generator) {
+    static const std::map<std::string, Generator> names = {
+        {"dfs", Generator::DFS},         {"eller", Generator::ELLER}, {"walls", Generator::WALLS},
+        {"kruskal", Generator::KRUSKAL}, {"prim", Generator::PRIM},   {"wilson", Generator::WILSON},
+        {"caves", Generator::CAVES},
+    };
+    auto it = names.find(name);
+    if (it == names.end()) {
+        return false;
+    }
+    generator = it->second;
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    int i = 1;
+    if (i < argc && argv[i][0] != '-') {
+        options.count = std::strtoull(argv[i++], nullptr, 10);
+    }
+    for (; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::printf("Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--size") {
+            options.size = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--seed") {
+            options.firstSeed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--threads") {
+            options.threads = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--generator" && parseGenerator(value, options.generator)) {
+        } else if (arg == "--format" && (value == "csv" || value == "bin")) {
+            options.binary = value == "bin";
+        } else if (arg == "--out") {
+            options.out = value;
+        } else {
+            std::printf("Unknown option %s %s\n", arg.c_str(), value.c_str());
+            return false;
+        }
+    }
+    if (options.out.empty()) {
+        options.out = options.binary ? "corpus.bin" : "corpus.csv";
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::FILE* file = std::fopen(options.out.c_str(), options.binary ? "wb" : "w");
+    if (!file) {
+        std::printf("Could not open %s\n", options.out.c_str());
+        return 1;
+    }
+
+    const int gridSize = options.size * 2 + 1;
+    if (options.binary) {
+        CorpusHeader header = {};
+        std::memcpy(header.magic, "OUBCORP", 8);
+        header.version = 1;
+        header.byteOrderMark = 0x01020304;
+        header.recordSize = sizeof(MazeMetrics);
+        header.generator = static_cast<std::uint32_t>(options.generator);
+        header.gridWidth = gridSize;
+        header.gridHeight = gridSize;
+        header.firstSeed = options.firstSeed;
+        header.count = options.count;
+        std::fwrite(&header, sizeof(header), 1, file);
+    } else {
+        std::fputs("seed,open_cells,dead_ends,junctions,exits,mean_corridor_length,branching_factor,center_to_exit,solution_length\n", file);
+    }
+
+    const std::uint64_t batchCount = (options.count + SEEDS_PER_BATCH - 1) / SEEDS_PER_BATCH;
+    const std::uint64_t maxBatchesAhead = static_cast<std::uint64_t>(options.threads) * 4;
+
+    // Workers claim batches in order and hand finished output to this thread,
+    // which writes them in seed order; they stall if they run too far ahead
+    std::atomic<std::uint64_t> nextBatch{0};
+    std::mutex mutex;
+    std::condition_variable batchDone;
+    std::condition_variable batchWritten;
+    std::map<std::uint64_t, std::string> finished;
+    std::uint64_t written = 0;
+
+    double sumDeadEnds = 0.0;
+    double sumSolution = 0.0;
+    std::uint64_t solved = 0;
+
+    auto work = [&]() {
+        Worker worker(options.size);
+        std::vector<MazeMetrics> records;
+        std::string text;
+
+        for (std::uint64_t batch = nextBatch++; batch < batchCount; batch = nextBatch++) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                batchWritten.wait(lock, [&]() { return batch < written + maxBatchesAhead; });
+            }
+
+            std::uint64_t first = batch * SEEDS_PER_BATCH;
+            std::uint64_t last = std::min(options.count, first + SEEDS_PER_BATCH);
+            records.clear();
+            text.clear();
+            for (std::uint64_t i = first; i < last; ++i) {
+                std::uint64_t seed = options.firstSeed + i;
+                generate(worker, options.generator, seed);
+                records.push_back(analyze(worker, seed));
+                if (!options.binary) appendCsvRow(text, records.back());
+            }
+            if (options.binary) {
+                text.assign(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(MazeMetrics));
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& metrics : records) {
+                sumDeadEnds += metrics.deadEnds;
+                if (metrics.solutionLength >= 0) {
+                    sumSolution += metrics.solutionLength;
+                    solved++;
+                }
+            }
+            finished.emplace(batch, std::move(text));
+            text = std::string();
+            batchDone.notify_one();
+        }
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < options.threads; ++i) {
+        workers.emplace_back(work);
+    }
+
+    while (written < batchCount) {
+        std::string text;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            batchDone.wait(lock, [&]() { return finished.count(written) > 0; });
+            text = std::move(finished[written]);
+            finished.erase(written);
+        }
+        std::fwrite(text.data(), 1, text.size(), file);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            written++;
+        }
+        batchWritten.notify_all();
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::fclose(file);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("%llu mazes (%dx%d grid) on %d threads in %.3f s: %.0f mazes/s -> %s\n",
+                static_cast<unsigned long long>(options.count), gridSize, gridSize, options.threads, seconds,
+                options.count / seconds, options.out.c_str());
+    if (options.count > 0) {
+        std::printf("mean dead ends %.2f, mean solution length %.2f (%llu solvable)\n", sumDeadEnds / options.count,
+                    solved > 0 ? sumSolution / solved : 0.0, static_cast<unsigned long long>(solved));
+    }
+    return 0;
+}